@@ -0,0 +1,110 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "../Empirical/include/emp/bits/BitSet.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+/**
+ *
+ * Purpose: Represents a binary checkpoint file being written. Values are
+ * stored as their raw in-memory bytes, so a checkpoint can only be read back
+ * by a build of the same program on the same platform.
+ *
+ */
+class CheckpointWriter {
+private:
+  std::ofstream out;
+
+public:
+  CheckpointWriter(const std::string & filename) : out(filename, std::ios::binary) {
+    if (!out) throw "Could not open checkpoint file for writing";
+  }
+
+  /**
+   * Input: A plain value (a number, a bool, or a trivially copyable object).
+   *
+   * Output: None
+   *
+   * Purpose: To append the value's bytes to the checkpoint.
+   */
+  template <typename T>
+  void Write(const T & value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written to a checkpoint directly");
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void WriteString(const std::string & str) {
+    Write((uint64_t) str.size());
+    out.write(str.data(), str.size());
+  }
+
+  /**
+   * Input: A bitset, such as an organism's tag.
+   *
+   * Output: None
+   *
+   * Purpose: To append the bitset to the checkpoint, 64 bits at a time.
+   */
+  template <size_t NUM_BITS>
+  void WriteBits(const emp::BitSet<NUM_BITS> & bits) {
+    for (size_t i = 0; i < (NUM_BITS + 63) / 64; i++) Write(bits.GetUInt64(i));
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To make sure everything written so far reached the file.
+   */
+  void Close() {
+    out.close();
+    if (!out) throw "Could not finish writing checkpoint file";
+  }
+};
+
+/**
+ *
+ * Purpose: Represents a binary checkpoint file being read back, in the same
+ * order CheckpointWriter wrote it.
+ *
+ */
+class CheckpointReader {
+private:
+  std::ifstream in;
+
+public:
+  CheckpointReader(const std::string & filename) : in(filename, std::ios::binary) {
+    if (!in) throw "Could not open checkpoint file for reading";
+  }
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be read from a checkpoint directly");
+    T value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    if (!in) throw "Checkpoint file ended unexpectedly";
+    return value;
+  }
+
+  template <typename T>
+  void Read(T & value) { value = Read<T>(); }
+
+  std::string ReadString() {
+    std::string str(Read<uint64_t>(), '\0');
+    in.read(str.data(), str.size());
+    if (!in) throw "Checkpoint file ended unexpectedly";
+    return str;
+  }
+
+  template <size_t NUM_BITS>
+  void ReadBits(emp::BitSet<NUM_BITS> & bits) {
+    for (size_t i = 0; i < (NUM_BITS + 63) / 64; i++) bits.SetUInt64(i, Read<uint64_t>());
+  }
+};
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef COLUMNAR_DATA_FILE_H
+#define COLUMNAR_DATA_FILE_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+#include "../Empirical/include/emp/data/DataFile.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+/**
+ *
+ * Purpose: Represents a data file whose columns are defined the same way as
+ * an emp::DataFile's (AddVar, AddMean, AddHistBin, ...), but which can be
+ * written in a compact binary columnar layout instead of CSV. In CSV mode it
+ * behaves exactly like an emp::DataFile.
+ *
+ * In binary mode every column is typed (64-bit integer or 64-bit float) and
+ * rows are buffered and appended in chunks, so nothing is formatted as text.
+ * Within a chunk, a column whose values are all equal is stored once, and an
+ * integer column is stored at the narrowest width that holds its values.
+ * stats_scripts/columnar_to_csv.py converts a binary file back to the CSV
+ * that the same columns would have produced. The layout (little-endian) is:
+ *
+ *   "SYMCOL01"                            magic
+ *   uint32 column count
+ *   for each column: uint8 type (0 = int64, 1 = float64),
+ *                    uint32 key length and key,
+ *                    uint32 description length and description
+ *   chunks until the end of the file:
+ *     uint32 row count
+ *     for each column: uint8 width, then either one 8-byte value shared by
+ *     every row (width 0) or one value of that many bytes per row (integers
+ *     are signed; floats always use width 8)
+ *
+ */
+class ColumnarDataFile : public emp::DataFile {
+public:
+  enum ColumnType : uint8_t { INT64 = 0, FLOAT64 = 1 };
+
+  static constexpr size_t CHUNK_ROWS = 64;
+
+private:
+  struct Column {
+    ColumnType type;
+    std::string key;
+    std::string desc;
+    std::function<uint64_t()> read; // returns the bits of the value to store
+    emp::vector<uint64_t> chunk;
+  };
+
+  bool binary = false;
+  bool schema_written = false;
+  bool resumed = false; // continued from a checkpoint, so the header is already in the file
+  size_t chunk_rows = 0;
+  emp::vector<Column> columns;
+
+  /**
+   * Input: A numeric value.
+   *
+   * Output: The 64 bits to store for the value in its column's type.
+   *
+   * Purpose: To convert a column value to its stored form.
+   */
+  template <typename T>
+  static uint64_t ToBits(T value) {
+    uint64_t bits;
+    if constexpr (std::is_floating_point_v<T>) {
+      double as_double = value;
+      std::memcpy(&bits, &as_double, sizeof(bits));
+    } else {
+      int64_t as_int = (int64_t) value;
+      std::memcpy(&bits, &as_int, sizeof(bits));
+    }
+    return bits;
+  }
+
+  /**
+   * Input: The column's key and description, and a function returning its
+   * value for the current row.
+   *
+   * Output: None
+   *
+   * Purpose: To record a typed column for binary output. The column type
+   * follows the type the function returns, which is the type CSV output
+   * would print.
+   */
+  template <typename FUN_T>
+  void AddColumn(const std::string & key, const std::string & desc, FUN_T fun) {
+    if (!binary) return;
+    if (schema_written) throw "Columns can't be added to a binary data file after its header is written";
+    using value_t = std::decay_t<decltype(fun())>;
+    static_assert(std::is_arithmetic_v<value_t>, "Binary data file columns must be numeric");
+    ColumnType type = std::is_floating_point_v<value_t> ? FLOAT64 : INT64;
+    columns.push_back({type, key, desc, [fun]() { return ToBits(fun()); }, {}});
+  }
+
+  template <typename T>
+  void WriteRaw(const T & value) {
+    os->write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void WriteString(const std::string & str) {
+    WriteRaw((uint32_t) str.size());
+    os->write(str.data(), str.size());
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To write the magic number and column schema at the start of a
+   * binary file.
+   */
+  void WriteSchema() {
+    if (schema_written) return;
+    schema_written = true;
+    if (resumed) return;
+    os->write("SYMCOL01", 8);
+    WriteRaw((uint32_t) columns.size());
+    for (const Column & column : columns) {
+      WriteRaw((uint8_t) column.type);
+      WriteString(column.key);
+      WriteString(column.desc);
+    }
+  }
+
+  /**
+   * Input: A column with buffered rows.
+   *
+   * Output: The number of bytes to store each of the column's buffered values
+   * in, or 0 if they are all the same.
+   *
+   * Purpose: To pick the most compact width that stores a chunk exactly.
+   */
+  static uint8_t ChunkWidth(const Column & column) {
+    bool constant = true;
+    int64_t low = 0, high = 0;
+    for (uint64_t bits : column.chunk) {
+      if (bits != column.chunk[0]) constant = false;
+      int64_t value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (value < low) low = value;
+      if (value > high) high = value;
+    }
+    if (constant) return 0;
+    if (column.type == FLOAT64) return 8;
+    for (uint8_t width : {1, 2, 4}) {
+      int64_t limit = int64_t(1) << (8 * width - 1);
+      if (low >= -limit && high < limit) return width;
+    }
+    return 8;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To append the buffered rows to a binary file as one chunk.
+   */
+  void WriteChunk() {
+    WriteSchema();
+    if (chunk_rows == 0) return;
+    WriteRaw((uint32_t) chunk_rows);
+    for (Column & column : columns) {
+      uint8_t width = ChunkWidth(column);
+      WriteRaw(width);
+      if (width == 0) {
+        WriteRaw(column.chunk[0]);
+      } else {
+        // values are stored little-endian, so the low bytes come first
+        for (uint64_t bits : column.chunk) os->write(reinterpret_cast<const char *>(&bits), width);
+      }
+      column.chunk.clear();
+    }
+    chunk_rows = 0;
+    os->flush();
+  }
+
+public:
+  ColumnarDataFile(const std::string & filename, bool _binary = false)
+    : emp::DataFile(filename), binary(_binary) {}
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To write any rows still buffered before the file is closed.
+   */
+  ~ColumnarDataFile() {
+    if (binary) WriteChunk();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether the file is written in the binary columnar layout.
+   *
+   * Purpose: To check the file's output format.
+   */
+  bool IsBinary() const { return binary; }
+
+  template <typename T>
+  void AddVar(const T & var, const std::string & key = "", const std::string & desc = "") {
+    emp::DataFile::AddVar(var, key, desc);
+    AddColumn(key, desc, [&var]() { return var; });
+  }
+
+  template <typename T>
+  void AddFun(const std::function<T()> & fun, const std::string & key = "", const std::string & desc = "") {
+    emp::DataFile::AddFun(fun, key, desc);
+    AddColumn(key, desc, fun);
+  }
+
+  template <typename NODE_T>
+  void AddMean(NODE_T & node, const std::string & key = "", const std::string & desc = "", bool reset = false) {
+    emp::DataFile::AddMean(node, key, desc, reset);
+    AddColumn(key, desc, [&node, reset]() { auto value = node.GetMean(); if (reset) node.Reset(); return value; });
+  }
+
+  template <typename NODE_T>
+  void AddTotal(NODE_T & node, const std::string & key = "", const std::string & desc = "", bool reset = false) {
+    emp::DataFile::AddTotal(node, key, desc, reset);
+    AddColumn(key, desc, [&node, reset]() { auto value = node.GetTotal(); if (reset) node.Reset(); return value; });
+  }
+
+  template <typename NODE_T>
+  void AddMin(NODE_T & node, const std::string & key = "", const std::string & desc = "", bool reset = false) {
+    emp::DataFile::AddMin(node, key, desc, reset);
+    AddColumn(key, desc, [&node, reset]() { auto value = node.GetMin(); if (reset) node.Reset(); return value; });
+  }
+
+  template <typename NODE_T>
+  void AddMax(NODE_T & node, const std::string & key = "", const std::string & desc = "", bool reset = false) {
+    emp::DataFile::AddMax(node, key, desc, reset);
+    AddColumn(key, desc, [&node, reset]() { auto value = node.GetMax(); if (reset) node.Reset(); return value; });
+  }
+
+  template <typename NODE_T>
+  void AddHistBin(NODE_T & node, size_t bin, const std::string & key = "", const std::string & desc = "", bool reset = false) {
+    emp::DataFile::AddHistBin(node, bin, key, desc, reset);
+    AddColumn(key, desc, [&node, bin, reset]() { auto value = node.GetHistCounts()[bin]; if (reset) node.Reset(); return value; });
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To print the column keys as the CSV header, or write the schema
+   * of a binary file.
+   */
+  void PrintHeaderKeys() {
+    if (binary) WriteSchema();
+    else if (!resumed) emp::DataFile::PrintHeaderKeys();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of bytes written to the file so far.
+   *
+   * Purpose: To bring the file up to date for a checkpoint, writing out any
+   * buffered rows, so that a resumed run can continue the file from here.
+   */
+  uint64_t Checkpoint() {
+    if (binary) WriteChunk();
+    os->flush();
+    return (uint64_t) os->tellp();
+  }
+
+  /**
+   * Input: The output a checkpointed run had written to this file.
+   *
+   * Output: None
+   *
+   * Purpose: To continue a file from a checkpoint. The earlier output is
+   * written back and the header is not repeated. This must be called before
+   * PrintHeaderKeys().
+   */
+  void Resume(const std::string & written) {
+    os->write(written.data(), written.size());
+    resumed = true;
+  }
+
+  using emp::DataFile::Update;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To record the current value of every column as a new row.
+   */
+  void Update() override {
+    if (!binary) {
+      emp::DataFile::Update();
+      return;
+    }
+    for (Column & column : columns) column.chunk.push_back(column.read());
+    if (++chunk_rows == CHUNK_ROWS) WriteChunk();
+  }
+};
+
+#endif
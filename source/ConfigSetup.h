@@ -2,7 +2,14 @@
 #define CONFIG_H
 #include "../Empirical/include/emp/config/config.hpp"
 
-const int TAG_LENGTH = 32;
+// the tag width in bits is fixed at compile time; build with -DSYM_TAG_LENGTH=128
+// (or make TAG_LENGTH=128) for longer tags
+#ifndef SYM_TAG_LENGTH
+#define SYM_TAG_LENGTH 32
+#endif
+const int TAG_LENGTH = SYM_TAG_LENGTH;
+static_assert(TAG_LENGTH == 32 || TAG_LENGTH == 64 || TAG_LENGTH == 128 || TAG_LENGTH == 256 || TAG_LENGTH == 512,
+  "SYM_TAG_LENGTH must be 32, 64, 128, 256 or 512");
 
 EMP_BUILD_CONFIG(SymConfigBase,
     GROUP(MAIN, "Global Settings"),
@@ -45,6 +52,7 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(PHYLOGENY_SNAPSHOT_INTERVAL, int, 10001, "How often to output phylogeny snapshots"),
     VALUE(NUM_PHYLO_BINS, size_t, 5, "How many bins should organisms be separated into if phylogeny is on?"),
     VALUE(PHYLOGENY_TAXON_TYPE, size_t, 0, "What are phylogeny taxa based on? 0 = binned genotypes values, 1 = exact phenotype values"),
+    VALUE(STREAM_PHYLOGENY, bool, 0, "Should the interaction counts of host taxa be written to a stream file when the taxa go extinct, rather than kept in memory until the next snapshot? Only those counts leave memory: the extinct ancestor taxa themselves stay in the host and symbiont phylogenies, since snapshots list every ancestor. Snapshots hold the same rows either way (0 for no, 1 for yes; needs TRACK_PHYLOGENY_INTERACTIONS)"),
 
     GROUP(MUTATION, "Mutation"),
     VALUE(MUTATION_SIZE, double, 0.002, "Standard deviation of the distribution to mutate by"),
@@ -74,6 +82,21 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(TAG_MUTATION_SIZE, double, 0.01, "What is the probability that any given position in the bitstring tag flips during mutation?"),
     VALUE(WRITE_TAG_MATRIX, bool, 0, "At the end of the experiment, should a similarity matrix of all persisting tags be generated?"),
     VALUE(TAG_MATRIX_SAMPLE_PROPORTION, double, 0.1, "What proportion of positions in the world should be sampled to produce the tag matrix from?"),
+    VALUE(TAG_MATRIX_BINARY, bool, 0, "Should the tag matrix also be written as a binary file of uint16 bit distances (.bin), with its row and column host positions in .rows and .cols files? (0 for no, 1 for yes)"),
     VALUE(STARTING_TAGS_ONE_PROB, double, 0, "What probability should initializing bits in tags have of being 1s? Hosted symbionts will be assigned their host's tag. (0 for basic, all-0 only tags)"),
+
+    GROUP(PERFORMANCE, "Settings for how the world is processed, which do not change the model"),
+    VALUE(UPDATE_THREADS, int, 1, "How many threads should process the world each update? Above 1, grid worlds are split into tiles that are processed in parallel (tiling requires GRID and is skipped if PHYLOGENY is on). Also sets how many threads compute the tag distance matrix, in any world"),
+    VALUE(TILE_SIZE, int, 16, "Minimum width and height, in cells, of the tiles used when UPDATE_THREADS is above 1 (at least 2)"),
+    VALUE(SCHEDULER, int, 0, "In what order should cells be processed each update when the world isn't split into tiles? 0 for every cell in a random order, 1 for random blocks of SCHEDULE_BLOCK_SIZE neighboring cells each in a random order, 2 for only the cells occupied when the update starts in a random order (only 2 skips empty cells, so an update's cost scales with the number of organisms rather than the grid area; 1 and 2 give different results from 0 for the same seed)"),
+    VALUE(SCHEDULE_BLOCK_SIZE, int, 1024, "How many neighboring cells are in each block when SCHEDULER is 1"),
+    VALUE(RANDOM_POOL, bool, 0, "Should organisms draw their random numbers from pools refilled in batches, reseeded from the world's generator every update? (0 for no, 1 for yes) Runs with the same seed and settings still match each other, but not runs made without pools"),
+    VALUE(KEYED_RANDOM, bool, 0, "Should every random draw made while processing a cell come from a counter-based generator addressed by SEED, update, cell, organism slot and purpose? (0 for no, 1 for yes) Each cell's draws then don't depend on the order cells are processed in or on UPDATE_THREADS, but runs differ from runs made without it. Takes precedence over RANDOM_POOL"),
+    VALUE(KEEP_SYM_ORDER, bool, 0, "Should a host's other symbionts keep their order when one dies? (0 for no: the last symbiont takes its place, 1 for yes: later symbionts shift down, and the one after it waits until the next update to be processed, as in older versions)"),
+    VALUE(BINARY_DATA_FILES, bool, 0, "Should data files be written in the compact binary columnar format (.cdata) instead of CSV? (0 for no, 1 for yes) stats_scripts/columnar_to_csv.py converts them back to CSV"),
+    VALUE(CHECKPOINT_INT, int, 0, "How frequently, in updates, should the whole world be saved to a checkpoint file that the run can be resumed from? Must be a multiple of DATA_INT, 0 for never (not available with PHYLOGENY)"),
+    VALUE(RESUME_CHECKPOINT, bool, 0, "Should the run resume from the checkpoint a run with the same FILE_PATH, FILE_NAME and SEED wrote, continuing its data files? (0 for no, 1 for yes)"),
+    VALUE(BATCH_FILE, std::string, "", "Name of a sweep file listing settings and the values to run each with. If set, every combination is run as its own replicate, several at once, instead of a single run (native only)"),
+    VALUE(BATCH_THREADS, int, 0, "How many replicates of a BATCH_FILE sweep should run at once? 0 to fill the machine"),
   )
 #endif
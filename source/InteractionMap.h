@@ -0,0 +1,207 @@
+#ifndef INTERACTION_MAP_H
+#define INTERACTION_MAP_H
+
+#include "../Empirical/include/emp/base/Ptr.hpp"
+#include "../Empirical/include/emp/base/vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+namespace datastruct {
+
+  /**
+   *
+   * Purpose: Represents how many times a host taxon has been seen with each
+   * symbiont taxon. Most host taxa only ever meet a few symbiont taxa, so the
+   * counts are kept in a vector sorted by symbiont taxon ID, which costs 16
+   * bytes per entry and no allocation beyond the vector itself. A taxon that
+   * meets more than FLAT_LIMIT symbiont taxa moves its counts into a hash map,
+   * so adding to it stays fast. The map is only allocated then, so a taxon
+   * that never spills carries just the vector and one null pointer.
+   *
+   */
+  class InteractionMap {
+  public:
+    using id_t = unsigned long long int;
+    using entry_t = std::pair<id_t, int>;
+    static constexpr size_t FLAT_LIMIT = 32;
+
+  private:
+    using spill_t = std::unordered_map<id_t, int>;
+
+    emp::vector<entry_t> flat;     // sorted by ID, while not spilled
+    emp::Ptr<spill_t> spill = nullptr; // the counts once spilled, else null
+
+    emp::vector<entry_t>::iterator FindFlat(id_t id) {
+      return std::lower_bound(flat.begin(), flat.end(), id,
+        [](const entry_t & entry, id_t id) { return entry.first < id; });
+    }
+
+  public:
+    InteractionMap() = default;
+    InteractionMap(const InteractionMap & other) : flat(other.flat) {
+      if (other.spill) spill = emp::NewPtr<spill_t>(*other.spill);
+    }
+    InteractionMap(InteractionMap && other) noexcept : flat(std::move(other.flat)), spill(other.spill) {
+      other.spill = nullptr;
+    }
+    ~InteractionMap() { if (spill) spill.Delete(); }
+
+    InteractionMap & operator=(const InteractionMap & other) {
+      if (this != &other) *this = InteractionMap(other);
+      return *this;
+    }
+    InteractionMap & operator=(InteractionMap && other) noexcept {
+      if (this != &other) {
+        if (spill) spill.Delete();
+        flat = std::move(other.flat);
+        spill = other.spill;
+        other.spill = nullptr;
+      }
+      return *this;
+    }
+
+    /**
+     * Input: The ID of the symbiont taxon, and how many interactions to add.
+     *
+     * Output: None
+     *
+     * Purpose: To count interactions with a symbiont taxon.
+     */
+    void Add(id_t id, int count = 1) {
+      if (spill) {
+        (*spill)[id] += count;
+        return;
+      }
+      auto it = FindFlat(id);
+      if (it != flat.end() && it->first == id) {
+        it->second += count;
+      } else if (flat.size() < FLAT_LIMIT) {
+        flat.insert(it, entry_t(id, count));
+      } else {
+        spill = emp::NewPtr<spill_t>();
+        spill->reserve(2 * FLAT_LIMIT);
+        spill->insert(flat.begin(), flat.end());
+        (*spill)[id] += count;
+        emp::vector<entry_t>().swap(flat);
+      }
+    }
+
+    /**
+     * Input: The ID of a symbiont taxon.
+     *
+     * Output: How many interactions with it have been counted (0 if none).
+     *
+     * Purpose: To look up one count.
+     */
+    int Get(id_t id) const {
+      if (spill) {
+        auto it = spill->find(id);
+        return it == spill->end() ? 0 : it->second;
+      }
+      auto it = std::lower_bound(flat.begin(), flat.end(), id,
+        [](const entry_t & entry, id_t id) { return entry.first < id; });
+      return (it != flat.end() && it->first == id) ? it->second : 0;
+    }
+
+    bool Has(id_t id) const { return Get(id) != 0; }
+    size_t size() const { return spill ? spill->size() : flat.size(); }
+    bool empty() const { return size() == 0; }
+    bool IsSpilled() const { return (bool) spill; }
+
+    // keeps the flat vector's room, but gives back a spilled map's memory
+    void clear() {
+      flat.clear();
+      if (spill) {
+        spill.Delete();
+        spill = nullptr;
+      }
+    }
+
+    /**
+     * Input: The function to call with each symbiont taxon ID and its count.
+     *
+     * Output: None
+     *
+     * Purpose: To visit every count in order of symbiont taxon ID.
+     */
+    template <typename FUN_T>
+    void ForEach(FUN_T && fun) const {
+      if (!spill) {
+        for (const entry_t & entry : flat) fun(entry.first, entry.second);
+        return;
+      }
+      emp::vector<entry_t> sorted(spill->begin(), spill->end());
+      std::sort(sorted.begin(), sorted.end());
+      for (const entry_t & entry : sorted) fun(entry.first, entry.second);
+    }
+
+    /**
+     * Input: None
+     *
+     * Output: The heap memory the counts take up, in bytes. For a spilled
+     * map, this estimates each node as the entry plus two pointers, and adds
+     * the map itself.
+     *
+     * Purpose: To account for the memory interaction tracking costs.
+     */
+    size_t GetMemoryBytes() const {
+      if (!spill) return flat.capacity() * sizeof(entry_t);
+      return sizeof(spill_t) + spill->bucket_count() * sizeof(void *) +
+        spill->size() * (sizeof(std::pair<const id_t, int>) + 2 * sizeof(void *));
+    }
+  };
+
+  /**
+   *
+   * Purpose: Represents interaction counts for every (host taxon, symbiont
+   * taxon) pair in one flat table. Pairs are appended as they are seen and
+   * then merged with Finalize(), which sorts them by host and then symbiont
+   * taxon ID and adds up the counts of repeated pairs.
+   *
+   */
+  class InteractionTable {
+  public:
+    using id_t = InteractionMap::id_t;
+    using key_t = std::pair<id_t, id_t>;
+    using entry_t = std::pair<key_t, int>;
+
+  private:
+    emp::vector<entry_t> entries;
+
+  public:
+    void Add(id_t host, id_t sym, int count = 1) { entries.emplace_back(key_t(host, sym), count); }
+    void clear() { entries.clear(); }
+
+    /**
+     * Input: None
+     *
+     * Output: None
+     *
+     * Purpose: To sort the table and merge repeated pairs into one entry each.
+     */
+    void Finalize() {
+      std::sort(entries.begin(), entries.end(),
+        [](const entry_t & a, const entry_t & b) { return a.first < b.first; });
+      size_t merged = 0;
+      for (size_t i = 0; i < entries.size(); i++) {
+        if (merged > 0 && entries[merged - 1].first == entries[i].first) {
+          entries[merged - 1].second += entries[i].second;
+        } else {
+          entries[merged++] = entries[i];
+        }
+      }
+      entries.resize(merged);
+    }
+
+    // the counts by (host, symbiont) pair; sorted and unique after Finalize()
+    const emp::vector<entry_t> & GetEntries() const { return entries; }
+
+    size_t GetMemoryBytes() const { return entries.capacity() * sizeof(entry_t); }
+  };
+
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef KEYED_RANDOM_H
+#define KEYED_RANDOM_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+#include "../Empirical/include/emp/math/Random.hpp"
+#include "PoissonTable.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ *
+ * Purpose: Represents a counter-based random number generator (Philox4x32-10)
+ * whose draws are addressed rather than sequential. Every draw is a pure
+ * function of the run's seed, the update, the cell being processed, the
+ * organism slot in that cell, the purpose of the draw, and how many draws
+ * that address has already made. So the numbers a cell receives don't depend
+ * on which cells were processed before it or on which thread processes it,
+ * and a single cell's draws can be regenerated on their own with Draw().
+ *
+ * Slot 0 is the cell's host, slots 1 and up its hosted symbionts (matching
+ * their positions), and FREE_SYM_SLOT its free-living symbiont.
+ *
+ */
+class KeyedRandom {
+public:
+  enum Purpose : uint32_t {
+    GENERAL,   // everything an organism draws outside of mutation
+    MUTATION,  // mutating offspring, so mutations don't shift the other draws
+    WORLD,     // seeds the world's generator for the cell (births, movement, ...)
+    NUM_PURPOSES
+  };
+
+  static constexpr uint32_t FREE_SYM_SLOT = 0xffffff;
+
+  using block_t = std::array<uint32_t, 4>;
+
+  /**
+   * Input: The counter and the key.
+   *
+   * Output: Four random 32-bit words.
+   *
+   * Purpose: To compute one Philox4x32 block with the standard 10 rounds.
+   */
+  static block_t Philox(block_t ctr, std::array<uint32_t, 2> key) {
+    for (size_t round = 0; round < 10; round++) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+      }
+      const uint64_t product0 = (uint64_t) 0xD2511F53 * ctr[0];
+      const uint64_t product1 = (uint64_t) 0xCD9E8D57 * ctr[2];
+      ctr = {(uint32_t) (product1 >> 32) ^ ctr[1] ^ key[0], (uint32_t) product1,
+             (uint32_t) (product0 >> 32) ^ ctr[3] ^ key[1], (uint32_t) product0};
+    }
+    return ctr;
+  }
+
+  /**
+   * Input: The address of a block of draws and its index within that address.
+   *
+   * Output: The block's four random words.
+   *
+   * Purpose: To regenerate any block a run drew, for replaying a cell.
+   */
+  static block_t Draw(uint64_t seed, uint32_t update, uint32_t cell, uint32_t slot, Purpose purpose, uint32_t index) {
+    return Philox({update, cell, (slot << 8) | purpose, index}, {(uint32_t) seed, (uint32_t) (seed >> 32)});
+  }
+
+private:
+  uint64_t seed = 0;
+  uint32_t update = 0;
+  uint32_t cell = 0;
+  uint32_t slot = 0;
+  Purpose purpose = GENERAL;
+
+  // the blocks each slot and purpose has drawn while processing this cell
+  emp::vector<std::array<uint32_t, NUM_PURPOSES>> block_counts;
+  std::array<uint32_t, NUM_PURPOSES> free_sym_block_counts{};
+
+  block_t block{};
+  size_t block_pos = 4;
+
+  // reseeded from the cell's WORLD address the first time the cell uses it
+  emp::Random cell_random;
+  bool cell_random_seeded = false;
+
+  // the Poisson distribution of the last mean drawn from, rebuilt when the mean changes
+  PoissonTable poisson_table;
+
+  uint32_t & BlockCount() {
+    if (slot == FREE_SYM_SLOT) return free_sym_block_counts[purpose];
+    if (slot >= block_counts.size()) block_counts.resize(slot + 1, {});
+    return block_counts[slot][purpose];
+  }
+
+  uint32_t NextWord() {
+    if (block_pos == 4) {
+      block = Draw(seed, update, cell, slot, purpose, BlockCount()++);
+      block_pos = 0;
+    }
+    return block[block_pos++];
+  }
+
+public:
+  void SetSeed(uint64_t _seed) { seed = _seed; }
+
+  /**
+   * Input: The update and the cell about to be processed.
+   *
+   * Output: None
+   *
+   * Purpose: To address the following draws to the host of that cell.
+   */
+  void StartCell(uint32_t _update, uint32_t _cell) {
+    update = _update;
+    cell = _cell;
+    for (auto & counts : block_counts) counts = {};
+    free_sym_block_counts = {};
+    slot = 0;
+    purpose = GENERAL;
+    block_pos = 4;
+    cell_random_seeded = false;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The generator for the world's own draws while processing this cell.
+   *
+   * Purpose: To get the cell's world generator, seeding it from the cell's
+   * WORLD address on first use, since most cells never draw from it.
+   */
+  emp::Random & GetCellRandom() {
+    if (!cell_random_seeded) {
+      block_t world_block = Draw(seed, update, cell, 0, WORLD, 0);
+      cell_random.ResetSeed((int) (world_block[0] & (uint32_t) std::numeric_limits<int>::max()) + 1);
+      cell_random_seeded = true;
+    }
+    return cell_random;
+  }
+
+  uint32_t GetSlot() const { return slot; }
+  Purpose GetPurpose() const { return purpose; }
+
+  /**
+   * Input: The slot, and the purpose, of the draws that follow.
+   *
+   * Output: None
+   *
+   * Purpose: To address the following draws. Returning to an address picks
+   * up after the draws it already made while processing this cell.
+   */
+  void SetAddress(uint32_t _slot, Purpose _purpose) {
+    if (_slot == slot && _purpose == purpose) return;
+    slot = _slot;
+    purpose = _purpose;
+    block_pos = 4;
+  }
+
+  double GetDouble() {
+    const uint64_t high = NextWord();
+    const uint64_t low = NextWord();
+    return ((high << 21) ^ (low >> 11)) * 0x1.0p-53; // 53 random bits, in [0, 1)
+  }
+  double GetDouble(double max) { return GetDouble() * max; }
+  double GetDouble(double min, double max) { return min + GetDouble() * (max - min); }
+  uint32_t GetUInt(uint32_t max) { return static_cast<uint32_t>(GetDouble() * max); }
+  uint32_t GetUInt(uint32_t min, uint32_t max) { return min + GetUInt(max - min); }
+  int GetInt(int max) { return static_cast<int>(GetUInt(static_cast<uint32_t>(max))); }
+  int GetInt(int min, int max) { return min + GetInt(max - min); }
+  bool P(double p) { return GetDouble() < p; }
+
+  double GetNormal(double mean = 0.0, double std = 1.0) {
+    const double radius = std::sqrt(-2.0 * std::log(1.0 - GetDouble()));
+    return mean + std * radius * std::cos(2.0 * M_PI * GetDouble());
+  }
+
+  uint32_t GetPoisson(double mean) {
+    // inverting a table takes one uniform, doesn't underflow for large means,
+    // and costs constant time while the mean stays the same
+    if (poisson_table.GetMean() != mean) poisson_table.Build(mean);
+    return poisson_table.Sample(GetDouble());
+  }
+};
+
+#endif
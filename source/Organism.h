@@ -2,7 +2,11 @@
 #define ORGANISM_H
 
 #include <string>
+#include "Checkpoint.h"
 #include "ConfigSetup.h"
+#include "InteractionMap.h"
+#include "OrganismPool.h"
+#include "SymbiontList.h"
 
 namespace datastruct {
 
@@ -14,14 +18,10 @@ namespace datastruct {
   };
 
   struct HostTaxonData : TaxonDataBase {
-        std::unordered_map<unsigned long long int, int> associated_syms;
+        InteractionMap associated_syms;
         void ClearInteractions() {associated_syms.clear();}
         void AddInteraction(emp::Ptr<emp::Taxon<taxon_info_t, TaxonDataBase>> sym) {
-          if (emp::Has(associated_syms, sym->GetID())){
-            associated_syms[sym->GetID()]++;
-          } else {
-            associated_syms[sym->GetID()] = 1;
-          }
+          associated_syms.Add(sym->GetID());
         }
   };
 
@@ -41,6 +41,11 @@ class Organism {
   bool operator==(const Organism &other) const {return (this == &other);}
   bool operator!=(const Organism &other) const {return !(*this == other);}
 
+  // Organisms of every mode are allocated from OrganismPool, so offspring
+  // reuse the memory of organisms that have died.
+  static void * operator new(size_t size) { return OrganismPool::Get().Allocate(size); }
+  static void operator delete(void * ptr, size_t size) { OrganismPool::Get().Release(ptr, size); }
+
   virtual std::string const GetName() {
     std::cout << "GetName called from Organism" << std::endl;
     throw "Organism method called!";}
@@ -188,10 +193,10 @@ class Organism {
 
   //Host functions
 
-  virtual emp::vector<emp::Ptr<Organism>>& GetSymbionts() {
+  virtual SymbiontList& GetSymbionts() {
     std::cout << "GetSymbionts called from Organism" << std::endl;
     throw "Organism method called!";}
-  virtual emp::vector<emp::Ptr<Organism>>& GetReproSymbionts() {
+  virtual SymbiontList& GetReproSymbionts() {
     std::cout << "GetReproSymbionts called from Organism" << std::endl;
     throw "Organism method called!";}
   virtual void SetResInProcess(double _in){
@@ -224,6 +229,12 @@ class Organism {
   virtual void ClearSyms() {
     std::cout << "ClearSyms called from Organism" << std::endl;
     throw "Organism method called!";}
+  virtual void SetInWorld(bool _in) {
+    std::cout << "SetInWorld called from Organism" << std::endl;
+    throw "Organism method called!";}
+  virtual bool IsInWorld() {
+    std::cout << "IsInWorld called from Organism" << std::endl;
+    throw "Organism method called!";}
   virtual void ClearReproSyms() {
     std::cout << "ClearReproSyms called from Organism" << std::endl;
     throw "Organism method called!";}
@@ -290,5 +301,13 @@ class Organism {
     std::cout << "ProcessPool called from Organism" << std::endl;
     throw "Organism method called!";}
 
+  //Checkpoint functions
+  virtual void WriteState(CheckpointWriter & out) {
+    std::cout << "WriteState called from Organism" << std::endl;
+    throw "Organism method called!";}
+  virtual void ReadState(CheckpointReader & in) {
+    std::cout << "ReadState called from Organism" << std::endl;
+    throw "Organism method called!";}
+
 };
 #endif
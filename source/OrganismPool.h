@@ -0,0 +1,192 @@
+#ifndef ORGANISM_POOL_H
+#define ORGANISM_POOL_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+/**
+ *
+ * Purpose: Represents the slab allocator behind every organism. Memory is
+ * handed out in slots grouped by object size, so each organism type (Host,
+ * Symbiont, Phage, ...) draws from its own set of slabs. Deleted organisms
+ * go on a free list for their size and the next organism of that size is
+ * constructed into the recycled slot, so high-turnover runs rarely reach
+ * malloc. Slabs are kept for the life of the program.
+ *
+ */
+class OrganismPool {
+public:
+  /**
+   *
+   * Purpose: Represents the usage counts of one size class, or of the whole
+   * pool when summed.
+   *
+   */
+  struct Stats {
+    size_t live = 0;      // objects currently allocated
+    size_t peak = 0;      // most objects ever allocated at once
+    size_t recycled = 0;  // allocations served from a freed slot
+    size_t slots = 0;     // slots carved out of slabs so far
+  };
+
+private:
+  static constexpr size_t SLOT_ALIGN = alignof(std::max_align_t);
+  static constexpr size_t NUM_CLASSES = 64;
+  static constexpr size_t SLOTS_PER_SLAB = 256;
+
+  struct FreeSlot {
+    FreeSlot * next;
+  };
+
+  struct SizeClass {
+    std::mutex mutex;
+    FreeSlot * free_list = nullptr;
+    size_t free_count = 0;
+    size_t free_fresh = 0; // never-used slots, always at the bottom of the free list
+    emp::vector<void *> slabs;
+    Stats stats;
+  };
+
+  std::array<SizeClass, NUM_CLASSES> classes;
+
+  OrganismPool() = default;
+
+  /**
+   * Input: An object size in bytes.
+   *
+   * Output: The index of the size class serving that size, or NUM_CLASSES if
+   * the object is too large to pool.
+   *
+   * Purpose: To round object sizes up to whole slot widths.
+   */
+  static size_t ClassIndex(size_t size) {
+    return (size + SLOT_ALIGN - 1) / SLOT_ALIGN - 1;
+  }
+
+  /**
+   * Input: The size class to grow, which must already be locked.
+   *
+   * Output: None
+   *
+   * Purpose: To allocate a new slab and thread its slots onto the free list.
+   */
+  static void AddSlab(SizeClass & size_class, size_t slot_size) {
+    char * slab = static_cast<char *>(::operator new(slot_size * SLOTS_PER_SLAB));
+    size_class.slabs.push_back(slab);
+    for (size_t i = SLOTS_PER_SLAB; i-- > 0;) {
+      FreeSlot * slot = reinterpret_cast<FreeSlot *>(slab + i * slot_size);
+      slot->next = size_class.free_list;
+      size_class.free_list = slot;
+    }
+    size_class.free_count += SLOTS_PER_SLAB;
+    size_class.free_fresh += SLOTS_PER_SLAB;
+    size_class.stats.slots += SLOTS_PER_SLAB;
+  }
+
+public:
+  OrganismPool(const OrganismPool &) = delete;
+  OrganismPool & operator=(const OrganismPool &) = delete;
+
+  /**
+   * Input: None
+   *
+   * Output: The program-wide pool.
+   *
+   * Purpose: To access the pool. It is never destroyed, so organisms deleted
+   * during static destruction can still return their memory.
+   */
+  static OrganismPool & Get() {
+    static OrganismPool * pool = new OrganismPool();
+    return *pool;
+  }
+
+  /**
+   * Input: The size in bytes of the object being constructed.
+   *
+   * Output: Memory for the object.
+   *
+   * Purpose: To hand out a recycled slot if one is free, or a fresh one.
+   */
+  void * Allocate(size_t size) {
+    size_t index = ClassIndex(size);
+    if (index >= NUM_CLASSES) return ::operator new(size);
+
+    SizeClass & size_class = classes[index];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    Stats & stats = size_class.stats;
+    if (!size_class.free_list) AddSlab(size_class, (index + 1) * SLOT_ALIGN);
+    // freed slots are pushed on top of the fresh ones, so they are reused first
+    if (size_class.free_count > size_class.free_fresh) stats.recycled++;
+    else size_class.free_fresh--;
+    FreeSlot * slot = size_class.free_list;
+    size_class.free_list = slot->next;
+    size_class.free_count--;
+    stats.live++;
+    if (stats.live > stats.peak) stats.peak = stats.live;
+    return slot;
+  }
+
+  /**
+   * Input: Memory returned by Allocate() and the size it was allocated with.
+   *
+   * Output: None
+   *
+   * Purpose: To put a deleted object's slot back on its free list.
+   */
+  void Release(void * ptr, size_t size) {
+    if (!ptr) return;
+    size_t index = ClassIndex(size);
+    if (index >= NUM_CLASSES) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    SizeClass & size_class = classes[index];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    FreeSlot * slot = static_cast<FreeSlot *>(ptr);
+    slot->next = size_class.free_list;
+    size_class.free_list = slot;
+    size_class.free_count++;
+    size_class.stats.live--;
+  }
+
+  /**
+   * Input: The size in bytes of an organism type, usually sizeof(T).
+   *
+   * Output: The usage counts of the size class serving that type. Types of
+   * the same rounded size share a class.
+   *
+   * Purpose: To monitor one organism type's allocations.
+   */
+  Stats GetStats(size_t size) {
+    size_t index = ClassIndex(size);
+    if (index >= NUM_CLASSES) return Stats();
+    std::lock_guard<std::mutex> lock(classes[index].mutex);
+    return classes[index].stats;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The usage counts summed over every size class.
+   *
+   * Purpose: To monitor all organism allocations at once.
+   */
+  Stats GetTotalStats() {
+    Stats total;
+    for (SizeClass & size_class : classes) {
+      std::lock_guard<std::mutex> lock(size_class.mutex);
+      total.live += size_class.stats.live;
+      total.peak += size_class.stats.peak;
+      total.recycled += size_class.stats.recycled;
+      total.slots += size_class.stats.slots;
+    }
+    return total;
+  }
+};
+
+#endif
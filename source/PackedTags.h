@@ -0,0 +1,116 @@
+#ifndef PACKED_TAGS_H
+#define PACKED_TAGS_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+#include "../Empirical/include/emp/bits/BitSet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents a column of tags packed into 64-bit words, laid out one
+ * tag after another, for counting how many bits tags differ in. The distance
+ * from one tag to a run of tags is a fixed number of XORs and popcounts per
+ * tag over contiguous memory, which the compiler unrolls and vectorizes
+ * (with hardware popcount when built for a CPU that has one, e.g. with
+ * -march=native).
+ *
+ * Distances are bit counts; dividing by NUM_BITS gives the same value as
+ * emp::HammingMetric<NUM_BITS>::calculate(). They fit in a uint16_t for
+ * every supported width.
+ *
+ */
+template <size_t NUM_BITS>
+class PackedTags {
+public:
+  static constexpr size_t NUM_WORDS = (NUM_BITS + 63) / 64;
+  using tag_t = std::array<uint64_t, NUM_WORDS>;
+
+private:
+  emp::vector<tag_t> tags;
+
+public:
+  /**
+   * Input: A tag.
+   *
+   * Output: The tag's bits packed into words.
+   *
+   * Purpose: To pack one tag.
+   */
+  static tag_t Pack(const emp::BitSet<NUM_BITS> & bits) {
+    tag_t packed;
+    for (size_t word = 0; word < NUM_WORDS; word++) packed[word] = bits.GetUInt64(word);
+    return packed;
+  }
+
+  /**
+   * Input: Two packed tags.
+   *
+   * Output: How many bits they differ in.
+   *
+   * Purpose: To compute the Hamming distance between two tags.
+   */
+  static uint32_t Distance(const tag_t & a, const tag_t & b) {
+    uint32_t distance = 0;
+    for (size_t word = 0; word < NUM_WORDS; word++) distance += std::popcount(a[word] ^ b[word]);
+    return distance;
+  }
+
+  static uint32_t Distance(const emp::BitSet<NUM_BITS> & a, const emp::BitSet<NUM_BITS> & b) {
+    return Distance(Pack(a), Pack(b));
+  }
+
+  void clear() { tags.clear(); }
+  void resize(size_t num_tags) { tags.resize(num_tags, tag_t{}); }
+  size_t size() const { return tags.size(); }
+  void push_back(const emp::BitSet<NUM_BITS> & bits) { tags.push_back(Pack(bits)); }
+  void Set(size_t pos, const emp::BitSet<NUM_BITS> & bits) { tags[pos] = Pack(bits); }
+  const tag_t & operator[](size_t pos) const { return tags[pos]; }
+
+  /**
+   * Input: A packed tag, the range of this column's tags to compare it to,
+   * and where to put one distance per tag in the range.
+   *
+   * Output: None
+   *
+   * Purpose: To compute the distances from one tag to many in one pass.
+   */
+  template <typename OUT_T>
+  void Distances(const tag_t & query, size_t begin, size_t end, OUT_T * out) const {
+    const tag_t * column = tags.data();
+    for (size_t pos = begin; pos < end; pos++) {
+      uint32_t distance = 0;
+      for (size_t word = 0; word < NUM_WORDS; word++) distance += std::popcount(query[word] ^ column[pos][word]);
+      out[pos - begin] = distance;
+    }
+  }
+
+  /**
+   * Input: The range of this column's tags to use as rows, the tags to use
+   * as columns, and where to put the (row_end - row_begin) x columns.size()
+   * distances, row by row.
+   *
+   * Output: None
+   *
+   * Purpose: To compute a block of rows of the distance matrix between two
+   * columns of tags. The column tags are visited in blocks that fit in the
+   * L1 cache, and every row is compared to a block before moving on to the
+   * next, so each column tag is read from memory once per block of rows.
+   */
+  template <typename OUT_T>
+  void DistanceMatrix(size_t row_begin, size_t row_end, const PackedTags & columns, OUT_T * out) const {
+    constexpr size_t COLUMN_BLOCK = std::max<size_t>(64, 16384 / sizeof(tag_t));
+    const size_t num_columns = columns.size();
+    for (size_t block = 0; block < num_columns; block += COLUMN_BLOCK) {
+      const size_t block_end = std::min(block + COLUMN_BLOCK, num_columns);
+      for (size_t row = row_begin; row < row_end; row++) {
+        columns.Distances(tags[row], block, block_end, out + (row - row_begin) * num_columns + block);
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef POISSON_TABLE_H
+#define POISSON_TABLE_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents a Poisson distribution with a fixed mean, tabulated so
+ * that a draw takes one uniform and constant expected time, however large the
+ * mean is. A draw is the inverse of the cumulative distribution at the
+ * uniform: the smallest k with u < P(X <= k).
+ *
+ * The cumulative distribution is tabulated until the tail left over is below
+ * what a double can resolve near 1, and a guide table of the same length
+ * gives, for each equal slice of [0, 1), the smallest k any uniform in the
+ * slice can map to. A draw looks up its slice and steps forward from there,
+ * which takes fewer than two steps on average.
+ *
+ */
+class PoissonTable {
+private:
+  double mean = -1;
+  emp::vector<double> cdf;        // cdf[k] = P(X <= k), with the last entry 1
+  emp::vector<uint32_t> guide;    // guide[slice] = first k with cdf[k] > slice / guide.size()
+
+public:
+  PoissonTable() = default;
+  PoissonTable(double _mean) { Build(_mean); }
+
+  /**
+   * Input: The mean of the distribution.
+   *
+   * Output: None
+   *
+   * Purpose: To tabulate the distribution for a new mean.
+   */
+  void Build(double _mean) {
+    emp_assert(_mean >= 0, "A Poisson distribution needs a mean of at least 0");
+    mean = _mean;
+    cdf.clear();
+    if (mean <= 0) {
+      cdf.push_back(1.0);
+    } else {
+      // terms are computed in log space, so large means don't underflow exp(-mean)
+      const double log_mean = std::log(mean);
+      double total = 0;
+      for (uint32_t k = 0; ; k++) {
+        const double pmf = std::exp(k * log_mean - mean - std::lgamma(k + 1.0));
+        total += pmf;
+        cdf.push_back(total);
+        if (k > mean && (pmf < 1e-17 || total >= 1.0)) break;
+      }
+      // the tail beyond here is too small to change a draw
+      cdf.back() = 1.0;
+    }
+
+    guide.resize(cdf.size());
+    uint32_t k = 0;
+    for (size_t slice = 0; slice < guide.size(); slice++) {
+      const double start = (double) slice / guide.size();
+      while (cdf[k] <= start) k++;
+      guide[slice] = k;
+    }
+  }
+
+  double GetMean() const { return mean; }
+  size_t GetSize() const { return cdf.size(); }
+
+  /**
+   * Input: A uniform draw in [0, 1).
+   *
+   * Output: The Poisson draw it maps to.
+   *
+   * Purpose: To draw from the distribution.
+   */
+  uint32_t Sample(double uniform) const {
+    emp_assert(!cdf.empty(), "PoissonTable needs to be built before drawing from it");
+    const size_t slice = (size_t) (uniform * guide.size());
+    uint32_t k = guide[slice < guide.size() ? slice : guide.size() - 1];
+    while (cdf[k] <= uniform) k++;
+    return k;
+  }
+};
+
+#endif
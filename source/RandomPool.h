@@ -0,0 +1,141 @@
+#ifndef RANDOM_POOL_H
+#define RANDOM_POOL_H
+
+#include "../Empirical/include/emp/base/Ptr.hpp"
+#include "../Empirical/include/emp/math/Random.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents pools of pre-generated uniform and standard normal
+ * random numbers, handed out through the same calls as emp::Random.
+ *
+ * The pools are refilled a block at a time by LANES independent xoshiro256+
+ * generators stepped side by side, which compilers turn into SIMD code, and
+ * normals are made from whole blocks of uniforms with the Box-Muller
+ * transform. Uniforms and normals come from separate generators, so each
+ * stream depends only on the seed and on how many numbers of its kind were
+ * drawn before, never on the block size or on how draws of the two kinds
+ * interleave.
+ *
+ */
+class RandomPool {
+public:
+  static constexpr size_t LANES = 8;
+  static constexpr size_t BLOCK_SIZE = 256; // a multiple of 2 * LANES
+
+private:
+  /**
+   *
+   * Purpose: Represents LANES xoshiro256+ generators, with their state laid
+   * out lane by lane so each step is a handful of vector instructions.
+   *
+   */
+  struct LaneGenerator {
+    alignas(64) std::array<uint64_t, LANES> s0{}, s1{}, s2{}, s3{};
+
+    void Seed(uint64_t seed) {
+      // splitmix64, as recommended for seeding xoshiro generators
+      auto next_seed = [&seed]() {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+      };
+      for (size_t lane = 0; lane < LANES; lane++) {
+        s0[lane] = next_seed();
+        s1[lane] = next_seed();
+        s2[lane] = next_seed();
+        s3[lane] = next_seed();
+      }
+    }
+
+    void Fill(double * out, size_t count) {
+      for (size_t i = 0; i < count; i += LANES) {
+        for (size_t lane = 0; lane < LANES; lane++) {
+          const uint64_t result = s0[lane] + s3[lane];
+          const uint64_t t = s1[lane] << 17;
+          s2[lane] ^= s0[lane];
+          s3[lane] ^= s1[lane];
+          s1[lane] ^= s2[lane];
+          s0[lane] ^= s3[lane];
+          s2[lane] ^= t;
+          s3[lane] = (s3[lane] << 45) | (s3[lane] >> 19);
+          out[i + lane] = (result >> 11) * 0x1.0p-53; // in [0, 1)
+        }
+      }
+    }
+  };
+
+  LaneGenerator uniform_gen;
+  LaneGenerator normal_gen;
+  alignas(64) std::array<double, BLOCK_SIZE> uniforms{};
+  alignas(64) std::array<double, BLOCK_SIZE> normals{};
+  size_t uniform_pos = BLOCK_SIZE;
+  size_t normal_pos = BLOCK_SIZE;
+
+  // the generator the pools were seeded from, which also serves the draws
+  // the pools don't cover
+  emp::Ptr<emp::Random> random = nullptr;
+
+  void RefillUniforms() {
+    uniform_gen.Fill(uniforms.data(), BLOCK_SIZE);
+    uniform_pos = 0;
+  }
+
+  void RefillNormals() {
+    constexpr size_t HALF = BLOCK_SIZE / 2;
+    alignas(64) std::array<double, BLOCK_SIZE> u;
+    normal_gen.Fill(u.data(), BLOCK_SIZE);
+    for (size_t i = 0; i < HALF; i++) {
+      const double radius = std::sqrt(-2.0 * std::log(1.0 - u[i])); // 1 - u is never 0
+      const double angle = 2.0 * M_PI * u[i + HALF];
+      normals[i] = radius * std::cos(angle);
+      normals[i + HALF] = radius * std::sin(angle);
+    }
+    normal_pos = 0;
+  }
+
+public:
+  /**
+   * Input: The generator to seed the pools from.
+   *
+   * Output: None
+   *
+   * Purpose: To start fresh pools, drawing a single number from the given
+   * generator. Anything left in the old pools is discarded.
+   */
+  void Reseed(emp::Random & source) {
+    const uint64_t seed = source.GetUInt64();
+    uniform_gen.Seed(seed);
+    normal_gen.Seed(seed ^ 0x6a09e667f3bcc909ull);
+    uniform_pos = BLOCK_SIZE;
+    normal_pos = BLOCK_SIZE;
+    random = &source;
+  }
+
+  double GetDouble() {
+    if (uniform_pos == BLOCK_SIZE) RefillUniforms();
+    return uniforms[uniform_pos++];
+  }
+  double GetDouble(double max) { return GetDouble() * max; }
+  double GetDouble(double min, double max) { return min + GetDouble() * (max - min); }
+  uint32_t GetUInt(uint32_t max) { return static_cast<uint32_t>(GetDouble() * max); }
+  uint32_t GetUInt(uint32_t min, uint32_t max) { return min + GetUInt(max - min); }
+  int GetInt(int max) { return static_cast<int>(GetUInt(static_cast<uint32_t>(max))); }
+  int GetInt(int min, int max) { return min + GetInt(max - min); }
+  bool P(double p) { return GetDouble() < p; }
+
+  double GetNormal(double mean = 0.0, double std = 1.0) {
+    if (normal_pos == BLOCK_SIZE) RefillNormals();
+    return mean + normals[normal_pos++] * std;
+  }
+
+  // Poisson draws are rare enough that they aren't pooled
+  uint32_t GetPoisson(double mean) { return random->GetPoisson(mean); }
+};
+
+#endif
@@ -188,6 +188,7 @@ public:
     random.ResetSeed(config.SEED());
     world.SetRandom(random);
 
+    world.UseModePolicy<Host, Symbiont>();
     world.Setup();
 
     p = world.GetPop();
@@ -225,7 +226,7 @@ public:
         //bool temp_passed = true;
         for (int x = 0; x < config.GRID_X(); x++){
             for (int y = 0; y < config.GRID_Y(); y++){
-                emp::vector<emp::Ptr<Organism>>& syms = p[i]->GetSymbionts(); // retrieve all syms for this host (assume only 1 sym for each host)
+                SymbiontList& syms = p[i]->GetSymbionts(); // retrieve all syms for this host (assume only 1 sym for each host)
                 // color setting for host and symbiont
 
                 std::string color_host = matchColor(p[i]->GetIntVal());
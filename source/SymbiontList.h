@@ -0,0 +1,167 @@
+#ifndef SYMBIONT_LIST_H
+#define SYMBIONT_LIST_H
+
+#include "../Empirical/include/emp/base/Ptr.hpp"
+#include "../Empirical/include/emp/base/vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+class Organism;
+
+/**
+ *
+ * Purpose: Represents the symbionts held by a host. The first
+ * INLINE_CAPACITY symbionts are stored inside the list itself, so a host
+ * that never holds more (SYM_LIMIT 1, the usual case) never allocates for
+ * its symbionts. Beyond that the list moves to the heap, and hosts reserve
+ * room for SYM_LIMIT symbionts at once so it only moves there once.
+ *
+ * It supports the parts of emp::vector that callers use (size(), [], at(),
+ * iteration, push_back() and erase()), converts to an emp::vector for
+ * callers that want their own copy, and compares equal to an emp::vector
+ * holding the same symbionts in the same order.
+ *
+ */
+class SymbiontList {
+public:
+  using value_type = emp::Ptr<Organism>;
+  using iterator = emp::Ptr<Organism> *;
+  using const_iterator = const emp::Ptr<Organism> *;
+  static constexpr size_t INLINE_CAPACITY = 1;
+
+private:
+  emp::Ptr<Organism> * heap = nullptr; // nullptr while the symbionts fit inline
+  uint32_t count = 0;
+  uint32_t heap_capacity = 0;
+  std::array<emp::Ptr<Organism>, INLINE_CAPACITY> inline_syms{};
+
+public:
+  SymbiontList() = default;
+
+  SymbiontList(const emp::vector<emp::Ptr<Organism>> & syms) {
+    reserve(syms.size());
+    for (emp::Ptr<Organism> sym : syms) push_back(sym);
+  }
+
+  SymbiontList(const SymbiontList & other) {
+    reserve(other.size());
+    for (emp::Ptr<Organism> sym : other) push_back(sym);
+  }
+
+  SymbiontList(SymbiontList && other) noexcept
+    : heap(other.heap), count(other.count), heap_capacity(other.heap_capacity), inline_syms(other.inline_syms) {
+    other.heap = nullptr;
+    other.count = 0;
+    other.heap_capacity = 0;
+  }
+
+  SymbiontList & operator=(SymbiontList other) noexcept {
+    std::swap(heap, other.heap);
+    std::swap(count, other.count);
+    std::swap(heap_capacity, other.heap_capacity);
+    std::swap(inline_syms, other.inline_syms);
+    return *this;
+  }
+
+  ~SymbiontList() { delete[] heap; }
+
+  emp::Ptr<Organism> * data() { return heap ? heap : inline_syms.data(); }
+  const emp::Ptr<Organism> * data() const { return heap ? heap : inline_syms.data(); }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  size_t capacity() const { return heap ? heap_capacity : INLINE_CAPACITY; }
+
+  emp::Ptr<Organism> & operator[](size_t i) { emp_assert(i < count); return data()[i]; }
+  const emp::Ptr<Organism> & operator[](size_t i) const { emp_assert(i < count); return data()[i]; }
+  emp::Ptr<Organism> & at(size_t i) {
+    if (i >= count) throw std::out_of_range("SymbiontList::at");
+    return data()[i];
+  }
+  const emp::Ptr<Organism> & at(size_t i) const {
+    if (i >= count) throw std::out_of_range("SymbiontList::at");
+    return data()[i];
+  }
+  emp::Ptr<Organism> & front() { return (*this)[0]; }
+  emp::Ptr<Organism> & back() { return (*this)[count - 1]; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + count; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + count; }
+
+  /**
+   * Input: The number of symbionts to make room for.
+   *
+   * Output: None
+   *
+   * Purpose: To move the list to a heap buffer with room for at least that
+   * many symbionts, if it doesn't have room already.
+   */
+  void reserve(size_t new_capacity) {
+    if (new_capacity <= capacity()) return;
+    emp::Ptr<Organism> * new_heap = new emp::Ptr<Organism>[new_capacity];
+    std::copy(begin(), end(), new_heap);
+    delete[] heap;
+    heap = new_heap;
+    heap_capacity = (uint32_t) new_capacity;
+  }
+
+  void push_back(emp::Ptr<Organism> sym) {
+    if (count == capacity()) reserve(std::max<size_t>(2 * capacity(), 2));
+    data()[count++] = sym;
+  }
+
+  void pop_back() { emp_assert(count > 0); count--; }
+
+  // keeps any heap buffer, so a host refilling its list doesn't allocate again
+  void clear() { count = 0; }
+
+  /**
+   * Input: The position of the symbiont to remove.
+   *
+   * Output: The position of the symbiont that now follows the removed one.
+   *
+   * Purpose: To remove a symbiont, keeping the others in order.
+   */
+  iterator erase(iterator pos) {
+    emp_assert(pos >= begin() && pos < end());
+    std::copy(pos + 1, end(), pos);
+    count--;
+    return pos;
+  }
+
+  /**
+   * Input: The index of the symbiont to remove.
+   *
+   * Output: None
+   *
+   * Purpose: To remove a symbiont in constant time by moving the last
+   * symbiont into its place.
+   */
+  void SwapRemove(size_t i) {
+    emp_assert(i < count);
+    data()[i] = data()[count - 1];
+    count--;
+  }
+
+  operator emp::vector<emp::Ptr<Organism>>() const {
+    return emp::vector<emp::Ptr<Organism>>(begin(), end());
+  }
+
+  // found by argument-dependent lookup, like std::size() is for an emp::vector
+  friend size_t size(const SymbiontList & list) { return list.size(); }
+
+  friend bool operator==(const SymbiontList & list, const emp::vector<emp::Ptr<Organism>> & syms) {
+    return std::equal(list.begin(), list.end(), syms.begin(), syms.end());
+  }
+
+  friend bool operator==(const SymbiontList & a, const SymbiontList & b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+};
+
+#endif
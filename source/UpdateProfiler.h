@@ -0,0 +1,135 @@
+#ifndef UPDATE_PROFILER_H
+#define UPDATE_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents where a world's update time goes: the time spent in
+ * each phase of SymWorld::Update() and how many events of each kind happened,
+ * since the profile file last wrote them out.
+ *
+ * Profiling is compiled in only with -DSYM_PROFILE (make profile-default and
+ * the other profile-* targets). Without it, the SYM_PROFILE_PHASE() and
+ * SYM_PROFILE_COUNT() hooks compile to nothing and no profile file is
+ * written. The hooks record into plain per-thread tallies, which the world
+ * collects into its profiler after each tile and each update, so hot paths
+ * never touch shared memory. Phases timed from several tile threads at once
+ * add up the time spent on every thread.
+ *
+ */
+class UpdateProfiler {
+public:
+  enum Phase {
+    WORLD_UPDATE,       // emp::World::Update(): signals, data files and host systematics
+    SCHEDULE,           // choosing the order cells are processed in
+    HOST_PROCESS,
+    FREE_SYM_PROCESS,
+    SYSTEMATICS,        // symbiont systematics
+    PHYLOGENY_SNAPSHOT,
+    GRAVEYARD,
+    NUM_PHASES
+  };
+
+  enum Event {
+    BIRTHS,             // hosts and horizontally transmitted or burst symbionts placed in the world
+    DEATHS,             // hosts, hosted symbionts and free-living symbionts removed
+    HORIZ_TRANS_ATTEMPTS,
+    VERT_TRANSMISSIONS,
+    LYSIS_BURSTS,
+    MOVEMENTS,          // free-living symbionts moving into a host or a new cell
+    NUM_EVENTS
+  };
+
+  static constexpr std::array<const char *, NUM_PHASES> PHASE_NAMES = {
+    "world_update", "schedule", "host_process", "free_sym_process", "systematics", "phylogeny_snapshot", "graveyard"};
+  static constexpr std::array<const char *, NUM_EVENTS> EVENT_NAMES = {
+    "births", "deaths", "horiz_trans_attempts", "vert_transmissions", "lysis_bursts", "movements"};
+
+private:
+  /**
+    *
+    * Purpose: Represents this thread's time and event tallies that have not
+    * been collected into a profiler yet.
+    *
+  */
+  static inline thread_local std::array<int64_t, NUM_PHASES> pending_ns{};
+  static inline thread_local std::array<uint64_t, NUM_EVENTS> pending_counts{};
+
+  // atomic, since every tile thread collects its own tallies
+  std::array<std::atomic<int64_t>, NUM_PHASES> phase_ns{};
+  std::array<std::atomic<uint64_t>, NUM_EVENTS> event_counts{};
+
+public:
+  /**
+   *
+   * Purpose: Represents a phase being timed, adding the time from its
+   * construction to its destruction to this thread's tallies.
+   *
+   */
+  class PhaseTimer {
+  private:
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    PhaseTimer(Phase _phase) : phase(_phase), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() { AddTime(phase, std::chrono::steady_clock::now() - start); }
+  };
+
+  static void AddTime(Phase phase, std::chrono::steady_clock::duration time) {
+    pending_ns[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  }
+
+  static void Count(Event event) { pending_counts[event]++; }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To move the calling thread's tallies into this profiler.
+   */
+  void Collect() {
+    for (size_t i = 0; i < NUM_PHASES; i++) {
+      if (pending_ns[i]) phase_ns[i].fetch_add(pending_ns[i], std::memory_order_relaxed);
+      pending_ns[i] = 0;
+    }
+    for (size_t i = 0; i < NUM_EVENTS; i++) {
+      if (pending_counts[i]) event_counts[i].fetch_add(pending_counts[i], std::memory_order_relaxed);
+      pending_counts[i] = 0;
+    }
+  }
+
+  double GetSeconds(Phase phase) const { return phase_ns[phase].load(std::memory_order_relaxed) / 1e9; }
+  uint64_t GetCount(Event event) const { return event_counts[event].load(std::memory_order_relaxed); }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To start a new profiling interval once the last one is written.
+   */
+  void Reset() {
+    for (auto & time : phase_ns) time.store(0, std::memory_order_relaxed);
+    for (auto & count : event_counts) count.store(0, std::memory_order_relaxed);
+  }
+};
+
+#ifdef SYM_PROFILE
+#define SYM_PROFILE_CONCAT_INNER(a, b) a##b
+#define SYM_PROFILE_CONCAT(a, b) SYM_PROFILE_CONCAT_INNER(a, b)
+// times the rest of the enclosing scope as the given UpdateProfiler::Phase
+#define SYM_PROFILE_PHASE(phase) \
+  UpdateProfiler::PhaseTimer SYM_PROFILE_CONCAT(sym_profile_timer_, __LINE__)(UpdateProfiler::phase)
+#define SYM_PROFILE_COUNT(event) UpdateProfiler::Count(UpdateProfiler::event)
+#else
+#define SYM_PROFILE_PHASE(phase)
+#define SYM_PROFILE_COUNT(event)
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "../Empirical/include/emp/base/vector.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ *
+ * Purpose: Represents a fixed set of worker threads that repeatedly run
+ * batches of independent jobs. The thread calling Run() takes part in the
+ * batch, so a pool of N threads only launches N-1 workers. Jobs are handed
+ * out one index at a time, so uneven jobs balance across the threads.
+ *
+ */
+class WorkerPool {
+private:
+  emp::vector<std::thread> workers;
+  std::mutex pool_mutex;
+  std::condition_variable start_cv;
+  std::condition_variable done_cv;
+
+  std::function<void(size_t)> job_fun;
+  size_t job_count = 0;
+  std::atomic<size_t> next_job{0};
+  size_t batch_id = 0;
+  size_t busy_workers = 0;
+  bool stopping = false;
+  std::exception_ptr first_error = nullptr;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To claim and run jobs from the current batch until none remain,
+   * holding on to the first exception a job throws so Run() can rethrow it.
+   */
+  void RunJobs() {
+    for (size_t job = next_job++; job < job_count; job = next_job++) {
+      try {
+        job_fun(job);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!first_error) first_error = std::current_exception();
+      }
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: The loop each worker thread runs, waiting for a new batch and
+   * then helping to finish it.
+   */
+  void WorkerLoop() {
+    size_t seen_batch = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        start_cv.wait(lock, [&]() { return stopping || batch_id != seen_batch; });
+        if (stopping) return;
+        seen_batch = batch_id;
+      }
+      RunJobs();
+      {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        busy_workers--;
+      }
+      done_cv.notify_one();
+    }
+  }
+
+public:
+  /**
+   * Input: The total number of threads that should work on each batch,
+   * including the thread that calls Run().
+   *
+   * Output: None
+   *
+   * Purpose: To construct a pool and launch its worker threads.
+   */
+  WorkerPool(size_t num_threads) {
+    for (size_t i = 1; i < num_threads; i++) {
+      workers.emplace_back([this]() { WorkerLoop(); });
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To stop and join the worker threads.
+   */
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      stopping = true;
+    }
+    start_cv.notify_all();
+    for (std::thread & worker : workers) worker.join();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of threads that work on each batch, including the
+   * calling thread.
+   *
+   * Purpose: To get the size of the pool.
+   */
+  size_t GetNumThreads() const { return workers.size() + 1; }
+
+  /**
+   * Input: The number of jobs in the batch, and the function to call with
+   * each job index.
+   *
+   * Output: None
+   *
+   * Purpose: To run fun(0) through fun(num_jobs-1) across the pool, returning
+   * once every job has finished. If any job throws, the first exception is
+   * rethrown here after the batch completes.
+   */
+  void Run(size_t num_jobs, std::function<void(size_t)> fun) {
+    if (num_jobs == 0) return;
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      job_fun = fun;
+      job_count = num_jobs;
+      next_job = 0;
+      first_error = nullptr;
+      busy_workers = workers.size();
+      batch_id++;
+    }
+    start_cv.notify_all();
+    RunJobs();
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    done_cv.wait(lock, [&]() { return busy_workers == 0; });
+    if (first_error) std::rethrow_exception(first_error);
+  }
+};
+
+#endif
@@ -5,6 +5,8 @@
 
 #include "SymWorld.h"
 
+#include <unordered_set>
+
 /**
 * Input: None.
 *
@@ -13,6 +15,7 @@
 * Purpose: To create and set up the data files (excluding for phylogeny) that contain data for the experiment.
 */
 void SymWorld::CreateDataFiles(){
+  SetLazyDataNodes(true);
   int TIMING_REPEAT = my_config->DATA_INT();
   std::string file_ending = "_SEED"+std::to_string(my_config->SEED())+".data";
 
@@ -27,6 +30,268 @@ void SymWorld::CreateDataFiles(){
   if (my_config->TAG_MATCHING()) {
     SetUpTagDistFile(my_config->FILE_PATH() + "TagDist" + my_config->FILE_NAME() + file_ending).SetTimingRepeat(TIMING_REPEAT);
   }
+#ifdef SYM_PROFILE
+  SetUpProfileFile(my_config->FILE_PATH() + "Profile" + my_config->FILE_NAME() + file_ending).SetTimingRepeat(TIMING_REPEAT);
+#endif
+}
+
+/**
+* Input: None.
+*
+* Output: None.
+*
+* Purpose: To create the data nodes that organisms record into while they are
+* being processed, so that tiles processed in parallel never race to create them.
+*/
+void SymWorld::CreateProcessDataNodes(){
+  GetHorizontalTransmissionAttemptCount();
+  GetHorizontalTransmissionTagFailCount();
+  GetHorizontalTransmissionSizeFailCount();
+  GetHorizontalTransmissionSuccessCount();
+  GetVerticalTransmissionAttemptCount();
+  GetVerticalTransmissionSuccessCount();
+}
+
+/**
+* Input: None.
+*
+* Output: The PopulationStore holding this world's population in columns.
+*
+* Purpose: To access the column store, creating it on first use. Creating it
+* registers the refill ahead of any data node that reads from it, so those
+* data nodes always see the population as it is at the start of the update.
+*/
+PopulationStore & SymWorld::GetPopulationStore(){
+  if (!population_store) {
+    population_store.New();
+    AddDataNodeScan({&population_store}, [this](){
+      SyncPopulationStore();
+    });
+    SyncPopulationStore();
+  }
+  RefreshDataNode(&population_store);
+  return *population_store;
+}
+
+/**
+* Input: None.
+*
+* Output: None.
+*
+* Purpose: To refill the column store from the current population, visiting
+* only the cells that hold organisms.
+*/
+void SymWorld::SyncPopulationStore(){
+  if (population_store) population_store->Gather(pop, sym_pop, occupancy.GetSortedCells());
+}
+
+/**
+* Input: The function that reads the column's value from a host.
+*
+* Output: The id of the new column in the PopulationStore.
+*
+* Purpose: To have the census walk collect one more value from every host,
+* for data nodes (including those of other modes) to read from the store.
+*/
+size_t SymWorld::AddHostCensusColumn(PopulationStore::extractor_t extractor){
+  size_t column = GetPopulationStore().AddHostColumn(extractor);
+  SyncPopulationStore();
+  return column;
+}
+
+/**
+* Input: The function that reads the column's value from a symbiont, and
+* whether free-living symbionts should be read too.
+*
+* Output: The id of the new column in the PopulationStore.
+*
+* Purpose: To have the census walk collect one more value from every
+* symbiont, for data nodes (including those of other modes) to read from the
+* store.
+*/
+size_t SymWorld::AddSymCensusColumn(PopulationStore::extractor_t extractor, bool free_living){
+  size_t column = GetPopulationStore().AddSymColumn(extractor, free_living);
+  SyncPopulationStore();
+  return column;
+}
+
+/**
+* Input: The update number.
+*
+* Output: Whether data files sample the data nodes this update.
+*
+* Purpose: To decide whether data node scans need to run this update.
+*/
+bool SymWorld::IsDataUpdate(size_t ud){
+  if (!lazy_data_nodes) return true;
+  int data_int = my_config->DATA_INT();
+  return data_int <= 0 || ud % data_int == 0;
+}
+
+/**
+* Input: The data nodes a scan fills, and the scan.
+*
+* Output: None.
+*
+* Purpose: To register the population scan behind one or more data nodes.
+* The scan runs at the start of every update that data files sample, and is
+* only marked out of date on the others; RefreshDataNode() runs it on demand.
+*/
+void SymWorld::AddDataNodeScan(std::initializer_list<const void *> nodes, std::function<void()> scan){
+  size_t id = data_node_scans.size();
+  data_node_scans.push_back(scan);
+  data_node_scan_stale.push_back(false);
+  for (const void * node : nodes) data_node_scan_ids[node] = id;
+  OnUpdate([this, id](size_t ud){
+    if (IsDataUpdate(ud)) {
+      data_node_scan_stale[id] = false;
+      data_node_scans[id]();
+    } else {
+      data_node_scan_stale[id] = true;
+    }
+  });
+}
+
+/**
+* Input: A data node.
+*
+* Output: None.
+*
+* Purpose: To bring a data node up to date with the current population if
+* its scan was skipped since it last ran.
+*/
+void SymWorld::RefreshDataNode(const void * node){
+  auto it = data_node_scan_ids.find(node);
+  if (it == data_node_scan_ids.end() || !data_node_scan_stale[it->second]) return;
+  data_node_scan_stale[it->second] = false;
+  data_node_scans[it->second]();
+}
+
+/**
+* Input: A host being placed in or removed from the world, and which of the
+* two is happening.
+*
+* Output: None.
+*
+* Purpose: To add or remove a host's symbionts from the population counts.
+* This runs inside AddOrgAt() and DoDeath(), which already hold the shared
+* state lock during tiled updates.
+*/
+void SymWorld::CountHost(emp::Ptr<Organism> host, bool placed){
+  host->SetInWorld(placed);
+  size_t sym_count = host->GetSymbionts().size();
+  if (placed) {
+    num_hosted_syms += sym_count;
+    if (sym_count == 0) num_uninfected_hosts++;
+  } else {
+    num_hosted_syms -= sym_count;
+    if (sym_count == 0) num_uninfected_hosts--;
+  }
+  if (track_tag_frequencies) CountHostTags(host, placed);
+}
+
+/**
+* Input: A host being placed in or removed from the world, and which of the
+* two is happening.
+*
+* Output: None.
+*
+* Purpose: To add or remove the tags of a host and its symbionts from the tag
+* frequencies. Only organisms that are hosts count, as in the scan the tag
+* data nodes used before. Like CountHost(), this expects the shared state
+* lock to be held.
+*/
+void SymWorld::CountHostTags(emp::Ptr<Organism> host, bool placed){
+  if (!host->IsHost()) return;
+  if (placed) {
+    host_tag_frequencies.Add(host->GetTag());
+    for (emp::Ptr<Organism> sym : host->GetSymbionts()) sym_tag_frequencies.Add(sym->GetTag());
+  } else {
+    host_tag_frequencies.Remove(host->GetTag());
+    for (emp::Ptr<Organism> sym : host->GetSymbionts()) sym_tag_frequencies.Remove(sym->GetTag());
+  }
+}
+
+/**
+* Input: The tag of a symbiont that has joined or left a placed host (or
+* changed while in one), and which of the two happened.
+*
+* Output: None.
+*
+* Purpose: To keep the symbiont tag frequencies up to date, if they are tracked.
+*/
+void SymWorld::CountSymTag(const emp::BitSet<TAG_LENGTH> & tag, bool added){
+  if (!track_tag_frequencies) return;
+  auto lock = LockSharedState();
+  if (added) sym_tag_frequencies.Add(tag);
+  else sym_tag_frequencies.Remove(tag);
+}
+
+/**
+* Input: None.
+*
+* Output: None.
+*
+* Purpose: To start tracking tag frequencies, counting the tags of every host
+* and hosted symbiont already in the world.
+*/
+void SymWorld::TrackTagFrequencies(){
+  if (track_tag_frequencies) return;
+  track_tag_frequencies = true;
+  host_tag_frequencies.clear();
+  sym_tag_frequencies.clear();
+  for (size_t i = 0; i < pop.size(); i++) {
+    if (pop[i]) CountHostTags(pop[i], true);
+  }
+}
+
+/**
+* Input: The number of symbionts a placed host had before and after a change.
+*
+* Output: None.
+*
+* Purpose: To update the population counts when a placed host gains or loses
+* symbionts.
+*/
+void SymWorld::CountHostedSymChange(size_t old_count, size_t new_count){
+  auto lock = LockSharedState();
+  num_hosted_syms = num_hosted_syms + new_count - old_count;
+  if (old_count == 0 && new_count > 0) num_uninfected_hosts--;
+  else if (old_count > 0 && new_count == 0) num_uninfected_hosts++;
+}
+
+/**
+* Input: None.
+*
+* Output: Whether the population counts, the occupancy index and (if tracked)
+* the tag frequencies match a full scan of the world.
+*
+* Purpose: To cross-check the population counts against the world in tests.
+* This scans the whole world, so nothing calls it while a run is updating.
+*/
+bool SymWorld::CheckPopulationCounts(){
+  size_t hosts = 0, hosted_syms = 0, uninfected_hosts = 0, free_syms = 0;
+  for (size_t i = 0; i < pop.size(); i++) {
+    if (pop[i]) {
+      hosts++;
+      size_t sym_count = pop[i]->GetSymbionts().size();
+      hosted_syms += sym_count;
+      if (sym_count == 0) uninfected_hosts++;
+    }
+    if (i < sym_pop.size() && sym_pop[i]) free_syms++;
+    if (occupancy.IsLive(i) != (pop[i] || (i < sym_pop.size() && sym_pop[i]))) return false;
+  }
+  if (track_tag_frequencies) {
+    emp::vector<emp::BitSet<TAG_LENGTH>> host_tags, sym_tags;
+    for (emp::Ptr<Organism> host : pop) {
+      if (!host || !host->IsHost()) continue;
+      host_tags.push_back(host->GetTag());
+      for (emp::Ptr<Organism> sym : host->GetSymbionts()) sym_tags.push_back(sym->GetTag());
+    }
+    if (!host_tag_frequencies.Matches(host_tags) || !sym_tag_frequencies.Matches(sym_tags)) return false;
+  }
+  return hosts == GetNumHosts() && hosted_syms == num_hosted_syms &&
+    uninfected_hosts == num_uninfected_hosts && free_syms == num_free_syms;
 }
 
 /**
@@ -106,7 +371,7 @@ emp::DataFile & SymWorld::SetupHostIntValFile(const std::string & filename) {
  * Purpose: To define which data nodes should be tracked by this data file. Defines
  * what columns should be called.
  */
-void SymWorld::SetupHostFileColumns(emp::DataFile & file){
+void SymWorld::SetupHostFileColumns(ColumnarDataFile & file){
   auto & node = GetHostIntValDataNode();
   auto & node1 = GetHostCountDataNode();
   auto & uninf_hosts_node = GetUninfectedHostsDataNode();
@@ -140,6 +405,35 @@ void SymWorld::SetupHostFileColumns(emp::DataFile & file){
 }
 
 
+/**
+ * Input: The address of the string representing the file to be
+ * created's name
+ *
+ * Output: The address of the DataFile that has been created.
+ *
+ * Purpose: To set up the file that will be used to track where update time
+ * goes: the seconds spent in each phase of Update() and the number of each
+ * kind of event, both since the previous row. Only written by builds
+ * compiled with -DSYM_PROFILE.
+ */
+emp::DataFile & SymWorld::SetUpProfileFile(const std::string & filename){
+  auto & file = SetupFile(filename);
+  file.AddVar(update, "update", "Update");
+  for (size_t phase = 0; phase < UpdateProfiler::NUM_PHASES; phase++) {
+    file.AddFun<double>([this, phase](){ return profiler.GetSeconds((UpdateProfiler::Phase) phase); },
+      std::string(UpdateProfiler::PHASE_NAMES[phase]) + "_sec", "Seconds spent in this phase of the update since the previous row");
+  }
+  for (size_t event = 0; event < UpdateProfiler::NUM_EVENTS; event++) {
+    file.AddFun<uint64_t>([this, event](){ return profiler.GetCount((UpdateProfiler::Event) event); },
+      UpdateProfiler::EVENT_NAMES[event], "Number of these events since the previous row");
+  }
+  file.AddFun<size_t>([this](){ return GetInteractionMemoryBytes(); },
+    "interaction_bytes", "Bytes of memory spent on tracking phylogeny interactions (0 unless TRACK_PHYLOGENY_INTERACTIONS is on)");
+  file.PrintHeaderKeys();
+  return file;
+}
+
+
 /**
  * Input: The address of the string representing the file to be
  * created's name
@@ -229,13 +523,60 @@ emp::DataFile& SymWorld::SetUpReproHistFile(const std::string& filename) {
 }
 
 
+/**
+ * Input: None.
+ *
+ * Output: The bytes of heap memory the host taxa's interaction counts take up.
+ *
+ * Purpose: To account for the memory TRACK_PHYLOGENY_INTERACTIONS costs,
+ * across the active, ancestor and outside host taxa.
+ */
+size_t SymWorld::GetInteractionMemoryBytes() {
+  if (!host_sys) return 0;
+  size_t bytes = 0;
+  for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetActive()) bytes += t->GetData().associated_syms.GetMemoryBytes();
+  for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetAncestors()) bytes += t->GetData().associated_syms.GetMemoryBytes();
+  for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetOutside()) bytes += t->GetData().associated_syms.GetMemoryBytes();
+  return bytes;
+}
+
+/**
+ * Input: None.
+ *
+ * Output: None.
+ *
+ * Purpose: To stream the interaction counts of extinct host taxa to a file
+ * and free them. An extinct taxon with living descendants stays in memory as
+ * an ancestor, since its descendants point to it, but its counts stop
+ * changing, and across a long run they are most of what ancestors hold. A
+ * taxon with no descendants is pruned as it goes extinct, and snapshots
+ * never include it, so its counts are not streamed.
+ */
+void SymWorld::SetUpPhylogenyStreams() {
+  if (!my_config->TRACK_PHYLOGENY_INTERACTIONS()) return;
+  std::string file_ending = my_config->FILE_NAME() + "_SEED" + std::to_string(my_config->SEED()) + ".data";
+  interaction_stream.SetPath(my_config->FILE_PATH() + "InteractionPhylogenyStream" + file_ending, {"host", "symbiont", "count"});
+
+  std::function<void(emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>>)> stream_interactions =
+    [this](emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t) {
+      if (!interaction_stream.IsSet() || t->GetNumOff() == 0) return;
+      t->GetData().associated_syms.ForEach([&](unsigned long long int sym_id, int count) {
+        interaction_stream.AddRow(emp::to_string(t->GetID()) + "," + emp::to_string(sym_id) + "," + emp::to_string(count));
+      });
+      t->GetData().associated_syms = datastruct::InteractionMap();
+    };
+  host_sys->OnExtinct(stream_interactions);
+}
+
 /**
  * Input: The address of the string representing the suffixes for the files to be created.
  *
  * Output: None.
  *
  * Purpose: To setup and write to the files that track the symbiont systematic information and
- * the host systematic information
+ * the host systematic information. With STREAM_PHYLOGENY on, the streamed
+ * interaction counts of taxa that are still ancestors are added after the
+ * ones in memory, so the files hold the same rows as without streaming.
  */
 void SymWorld::WritePhylogenyFile(const std::string & filename) {
   sym_sys->Snapshot("SymSnapshot_"+filename);
@@ -246,78 +587,42 @@ void SymWorld::WritePhylogenyFile(const std::string & filename) {
     // interaction_file << "host, symbiont, host_interaction, sym_interaction, count";
     interaction_file << "host, symbiont, count";
 
-    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetActive()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
-      }
-    }
-
-    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetAncestors()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
-      }
-    }
-
-    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetOutside()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," + 
-          // emp::to_string(interaction.first->GetInfo()) + "," + 
-          emp::to_string(interaction.second);
-      }
-    }
+    // each host taxon's counts come out in order of symbiont taxon ID
+    auto write_interactions = [&interaction_file](emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t) {
+      t->GetData().associated_syms.ForEach([&](unsigned long long int sym_id, int count) {
+        interaction_file << emp::to_string(t->GetID()) + "," + emp::to_string(sym_id) + "," + emp::to_string(count);
+      });
+    };
+    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetActive()) write_interactions(t);
+    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetAncestors()) write_interactions(t);
+    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetOutside()) write_interactions(t);
 
     interaction_file.Write("InteractionSnapshot_" + filename);
+
+    // streamed counts belong to taxa that were ancestors when they went
+    // extinct; those pruned since are no longer in the snapshot
+    std::unordered_set<std::string> ancestor_ids;
+    for (emp::Ptr<emp::Taxon<taxon_info_t, datastruct::HostTaxonData>> t : host_sys->GetAncestors()) ancestor_ids.insert(emp::to_string(t->GetID()));
+    interaction_stream.AppendTo("InteractionSnapshot_" + filename, [&ancestor_ids](const emp::vector<std::string> & fields) {
+      return ancestor_ids.count(fields[0]) > 0;
+    });
   }
   if (my_config->WRITE_CURRENT_INTERACTION_COUNTS()) {
     emp::File cur_interaction_file;
     cur_interaction_file << "host,symbiont,count";
-    std::unordered_map<unsigned long long int, std::unordered_map<unsigned long long int, int>> current_interactions;
+    datastruct::InteractionTable current_interactions;
 
-    for (size_t i = 0; i < GetSize(); i++) {
+    for (size_t i : occupancy.GetCells()) {
       if (IsOccupied(i)) {
         unsigned long long int host_taxon = pop[i]->GetTaxon()->GetID();
-        for (auto sym : pop[i]->GetSymbionts()) {
-          unsigned long long int sym_taxon = sym->GetTaxon()->GetID();
-          if (!current_interactions.contains(host_taxon)) {
-            std::unordered_map<unsigned long long int, int> syms_map = { std::pair(sym_taxon, 1) };
-            current_interactions.emplace(host_taxon, syms_map);
-          }
-          else if (!current_interactions.at(host_taxon).contains(sym_taxon)) {
-            current_interactions.at(host_taxon).emplace(sym_taxon, 1);
-          }
-          else {
-            current_interactions.at(host_taxon).at(sym_taxon)++;
-          }
-        }
+        for (auto sym : pop[i]->GetSymbionts()) current_interactions.Add(host_taxon, sym->GetTaxon()->GetID());
       }
     }
+    // sorted by host and then symbiont taxon ID
+    current_interactions.Finalize();
 
-    for (auto host_pair : current_interactions) {
-      for (auto sym_pair : host_pair.second) {
-        cur_interaction_file << emp::to_string(host_pair.first) + "," + emp::to_string(sym_pair.first) + "," + emp::to_string(sym_pair.second);
-      }
+    for (const datastruct::InteractionTable::entry_t & entry : current_interactions.GetEntries()) {
+      cur_interaction_file << emp::to_string(entry.first.first) + "," + emp::to_string(entry.first.second) + "," + emp::to_string(entry.second);
     }
 
     cur_interaction_file.Write("CurrentInteractionsSnapshot_" + filename);
@@ -338,7 +643,7 @@ void SymWorld::MapPhylogenyInteractions() {
     t->GetData().ClearInteractions();
   }
 
-  for (size_t pos = 0; pos < pop.size(); pos++) {
+  for (size_t pos : occupancy.GetCells()) {
     if (!IsOccupied(pos)) {
       continue;
     }
@@ -500,10 +805,10 @@ void SymWorld::WriteOrgDumpFile(const std::string& filename) {
   if (my_config->TAG_MATCHING()) out_file << ",host_tag,sym_tag,tag_distance";
   out_file << "\n";
 
-  for (size_t i = 0; i < size(); i++) {
+  for (size_t i : occupancy.GetSortedCells()) {
     if (IsOccupied(i)) {
       if (pop[i]->HasSym()) {
-        emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
+        SymbiontList& symbionts = pop[i]->GetSymbionts();
         for (size_t j = 0; j < symbionts.size(); j++) {
           out_file << pop[i]->GetIntVal() << "," << symbionts[j]->GetIntVal() << "," << pop[i]->GetReproCount() << 
             "," << pop[i]->GetTowardsPartnerCount() << "," << pop[i]->GetFromPartnerCount() << 
@@ -528,40 +833,95 @@ void SymWorld::WriteOrgDumpFile(const std::string& filename) {
   out_file.close();
 }
 
+/**
+ * Input: The name of the file to write the matrix to.
+ *
+ * Output: None.
+ *
+ * Purpose: To write the tag distance from every sampled host (rows) to every
+ * sampled symbiont (columns) as CSV, and, with TAG_MATRIX_BINARY, as a binary
+ * matrix of uint16 bit counts in native byte order that can be memory-mapped
+ * (e.g. numpy.memmap with shape (rows, columns)). The .rows and .cols files
+ * hold the host position of each row and column, one per line. Blocks of rows
+ * are computed across UPDATE_THREADS threads and written in order.
+ */
 void SymWorld::WriteTagMatrixFile(const std::string& filename) {
-  std::ofstream out_file(filename);
-
   emp::vector<size_t> sampled_positions = emp::Choose(GetRandom(), GetSize(), my_config->TAG_MATRIX_SAMPLE_PROPORTION() * GetSize());
 
-  // write the host position of every sym
-  out_file << ',';
+  emp::vector<size_t> row_positions;
+  emp::vector<size_t> column_positions;
+  PackedTags<TAG_LENGTH> host_tags;
+  PackedTags<TAG_LENGTH> sym_tags;
   for (size_t i : sampled_positions) {
     if (IsOccupied(i)) {
-      if (pop[i]->HasSym()) {
-        emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-        for (size_t j = 0; j < symbionts.size(); j++) {
-          out_file << i << ","; // for mulit-infection, have non-unique ids (or change this!)
-        }
+      row_positions.push_back(i);
+      host_tags.push_back(pop[i]->GetTag());
+      for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
+        column_positions.push_back(i); // for mulit-infection, have non-unique ids (or change this!)
+        sym_tags.push_back(sym->GetTag());
       }
     }
   }
+  const size_t num_rows = row_positions.size();
+  const size_t num_columns = column_positions.size();
+
+  std::ofstream out_file(filename);
+  // write the host position of every sym
+  out_file << ',';
+  for (size_t i : column_positions) out_file << i << ",";
   out_file << "\n";
 
-  // for every host, calculate the tag distance to every sym
-  for (size_t k : sampled_positions) {
-    if (IsOccupied(k)) {
-      out_file << k << ',';
-
-      // calculate tag distance to every sym
-      for (size_t i : sampled_positions) {
-        if (IsOccupied(i) && pop[i]->HasSym()) {
-          emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-          for (size_t j = 0; j < symbionts.size(); j++) {
-            out_file << hamming_metric->calculate(pop[k]->GetTag(), symbionts[j]->GetTag()) << ",";
-          }
-        }
+  std::ofstream binary_file;
+  if (my_config->TAG_MATRIX_BINARY()) {
+    binary_file.open(filename + ".bin", std::ios::binary);
+    std::ofstream rows_file(filename + ".rows");
+    for (size_t i : row_positions) rows_file << i << "\n";
+    std::ofstream columns_file(filename + ".cols");
+    for (size_t i : column_positions) columns_file << i << "\n";
+  }
+
+  // there are only TAG_LENGTH + 1 distances, so format each once
+  emp::vector<std::string> distance_text(TAG_LENGTH + 1);
+  for (size_t distance = 0; distance <= (size_t) TAG_LENGTH; distance++) {
+    std::stringstream text;
+    text << (double) distance / TAG_LENGTH << ",";
+    distance_text[distance] = text.str();
+  }
+
+  // each job fills a block of at most about a million distances, and every
+  // thread gets a job; a batch of jobs (one per thread) is computed and then
+  // written before the next
+  const size_t num_threads = std::max(1, my_config->UPDATE_THREADS());
+  const size_t rows_per_job = std::clamp<size_t>((1 << 20) / std::max<size_t>(num_columns, 1), 1,
+    std::max<size_t>((num_rows + num_threads - 1) / num_threads, 1));
+  const size_t rows_per_batch = rows_per_job * num_threads;
+  emp::vector<uint16_t> distances(std::min(rows_per_batch, num_rows) * num_columns);
+  emp::vector<std::string> job_text(num_threads);
+
+  for (size_t batch = 0; batch < num_rows; batch += rows_per_batch) {
+    const size_t batch_end = std::min(batch + rows_per_batch, num_rows);
+    const size_t num_jobs = (batch_end - batch + rows_per_job - 1) / rows_per_job;
+    auto run_job = [&](size_t job) {
+      const size_t row_begin = batch + job * rows_per_job;
+      const size_t row_end = std::min(row_begin + rows_per_job, batch_end);
+      uint16_t * block = distances.data() + (row_begin - batch) * num_columns;
+      host_tags.DistanceMatrix(row_begin, row_end, sym_tags, block);
+
+      std::string & text = job_text[job];
+      text.clear();
+      for (size_t row = row_begin; row < row_end; row++) {
+        text += std::to_string(row_positions[row]) + ',';
+        const uint16_t * row_distances = block + (row - row_begin) * num_columns;
+        for (size_t column = 0; column < num_columns; column++) text += distance_text[row_distances[column]];
+        text += '\n';
       }
-      out_file << "\n";
+    };
+    if (num_threads > 1 && num_jobs > 1) GetUpdatePool(num_threads).Run(num_jobs, run_job);
+    else for (size_t job = 0; job < num_jobs; job++) run_job(job);
+
+    for (size_t job = 0; job < num_jobs; job++) out_file << job_text[job];
+    if (binary_file.is_open()) {
+      binary_file.write(reinterpret_cast<const char *>(distances.data()), (batch_end - batch) * num_columns * sizeof(uint16_t));
     }
   }
   out_file.close();
@@ -635,15 +995,12 @@ void SymWorld::WriteTagMatrixFile(const std::string& filename) {
 emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
   if(!data_node_hostcount) {
     data_node_hostcount.New();
-    OnUpdate([this](size_t){
+    AddDataNodeScan({&data_node_hostcount}, [this](){
       data_node_hostcount -> Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostcount->AddDatum(1);
-        }
-      }
+      data_node_hostcount->AddDatum(GetNumHosts());
     });
   }
+  RefreshDataNode(&data_node_hostcount);
   return *data_node_hostcount;
 }
 
@@ -660,18 +1017,12 @@ emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
   if(!data_node_symcount) {
     data_node_symcount.New();
-    OnUpdate([this](size_t){
+    AddDataNodeScan({&data_node_symcount}, [this](){
       data_node_symcount -> Reset();
-      for (size_t i = 0; i < pop.size(); i++){
-        if(IsOccupied(i)){
-          data_node_symcount->AddDatum((pop[i]->GetSymbionts()).size());
-        }
-        if(sym_pop[i]){
-          data_node_symcount->AddDatum(1);
-        }
-      }
+      data_node_symcount->AddDatum(GetNumHostedSyms() + GetNumFreeSyms());
     });
   }
+  RefreshDataNode(&data_node_symcount);
   return *data_node_symcount;
 }
 
@@ -688,15 +1039,12 @@ emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode(){
   if (!data_node_hostedsymcount) {
     data_node_hostedsymcount.New();
-    OnUpdate([this](size_t){
+    AddDataNodeScan({&data_node_hostedsymcount}, [this](){
       data_node_hostedsymcount->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostedsymcount->AddDatum(pop[i]->GetSymbionts().size());
-        }
-      }
+      data_node_hostedsymcount->AddDatum(GetNumHostedSyms());
     });
   }
+  RefreshDataNode(&data_node_hostedsymcount);
   return *data_node_hostedsymcount;
 }
 
@@ -713,15 +1061,12 @@ emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode(){
 emp::DataMonitor<int>& SymWorld::GetCountFreeSymsDataNode(){
   if (!data_node_freesymcount) {
     data_node_freesymcount.New();
-    OnUpdate([this](size_t){
+    AddDataNodeScan({&data_node_freesymcount}, [this](){
       data_node_freesymcount->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (sym_pop[i]){
-          data_node_freesymcount->AddDatum(1);
-        }
-      }
+      data_node_freesymcount->AddDatum(GetNumFreeSyms());
     });
   }
+  RefreshDataNode(&data_node_freesymcount);
   return *data_node_freesymcount;
 }
 
@@ -739,18 +1084,12 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
   //keep track of host organisms that are uninfected
   if(!data_node_uninf_hosts) {
     data_node_uninf_hosts.New();
-    OnUpdate([this](size_t){
-  data_node_uninf_hosts -> Reset();
-
-  for (size_t i = 0; i < pop.size(); i++) {
-    if(IsOccupied(i)) {
-      if((pop[i]->GetSymbionts()).empty()) {
-        data_node_uninf_hosts->AddDatum(1);
-      }
-    } //endif
-  } //end for
-}); //end OnUpdate
+    AddDataNodeScan({&data_node_uninf_hosts}, [this](){
+      data_node_uninf_hosts -> Reset();
+      data_node_uninf_hosts->AddDatum(GetNumUninfectedHosts());
+    }); //end AddDataNodeScan
   } //end if
+  RefreshDataNode(&data_node_uninf_hosts);
   return *data_node_uninf_hosts;
 }
 
@@ -769,15 +1108,18 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode() {
   if (!data_node_hostintval) {
     data_node_hostintval.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_hostintval}, [this](){
       data_node_hostintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++){
-        if (IsOccupied(i)){
-          data_node_hostintval->AddDatum(pop[i]->GetIntVal());
+      const PopulationStore & store = GetPopulationStore();
+      for (size_t i : store.live_cells) {
+        if (store.occupied[i]){
+          data_node_hostintval->AddDatum(store.host_int_val[i]);
         }
       }
     });
   }
+  RefreshDataNode(&data_node_hostintval);
   data_node_hostintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_hostintval;
 }
@@ -795,22 +1137,21 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode(
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode() {
   if (!data_node_symintval) {
     data_node_symintval.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_symintval}, [this](){
       data_node_symintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_symintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_symintval->AddDatum(sym_pop[i]->GetIntVal());
+      const PopulationStore & store = GetPopulationStore();
+      for (size_t i : store.live_cells) {
+        for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+          data_node_symintval->AddDatum(store.sym_int_val[j]);
+        }//close for
+        if (store.free_sym_present[i]) {
+          data_node_symintval->AddDatum(store.free_sym_int_val[i]);
         } //close if
       }//close for
     });
   }
+  RefreshDataNode(&data_node_symintval);
   data_node_symintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_symintval;
 }
@@ -828,15 +1169,18 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode()
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNode() {
   if (!data_node_freesymintval) {
     data_node_freesymintval.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_freesymintval}, [this](){
       data_node_freesymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesymintval->AddDatum(sym_pop[i]->GetIntVal());
+      const PopulationStore & store = GetPopulationStore();
+      for (size_t i : store.live_cells) {
+        if (store.free_sym_present[i]) {
+          data_node_freesymintval->AddDatum(store.free_sym_int_val[i]);
         } //close if
       }//close for
     });
   }
+  RefreshDataNode(&data_node_freesymintval);
   data_node_freesymintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_freesymintval;
 }
@@ -853,19 +1197,17 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNod
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataNode() {
   if (!data_node_hostedsymintval) {
     data_node_hostedsymintval.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_hostedsymintval}, [this](){
       data_node_hostedsymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_hostedsymintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }//close if
+      const PopulationStore & store = GetPopulationStore();
+      // the symbiont table is grouped by host, so every hosted symbiont is one contiguous run
+      for (size_t j = 0; j < store.GetNumHostedSyms(); j++) {
+        data_node_hostedsymintval->AddDatum(store.sym_int_val[j]);
       }//close for
     });
   }
+  RefreshDataNode(&data_node_hostedsymintval);
   data_node_hostedsymintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_hostedsymintval;
 }
@@ -883,22 +1225,21 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataNode() {
   if (!data_node_syminfectchance) {
     data_node_syminfectchance.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_syminfectchance}, [this](){
       data_node_syminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_syminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_syminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
+      const PopulationStore & store = GetPopulationStore();
+      for (size_t i : store.live_cells) {
+        for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+          data_node_syminfectchance->AddDatum(store.sym_infection_chance[j]);
+        }//close for
+        if (store.free_sym_present[i]) {
+          data_node_syminfectchance->AddDatum(store.free_sym_infection_chance[i]);
         } //close if
       }//close for
     });
   }
+  RefreshDataNode(&data_node_syminfectchance);
   data_node_syminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_syminfectchance;
 }
@@ -917,15 +1258,18 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceDataNode() {
   if (!data_node_freesyminfectchance) {
     data_node_freesyminfectchance.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_freesyminfectchance}, [this](){
       data_node_freesyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesyminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
+      const PopulationStore & store = GetPopulationStore();
+      for (size_t i : store.live_cells) {
+        if (store.free_sym_present[i]) {
+          data_node_freesyminfectchance->AddDatum(store.free_sym_infection_chance[i]);
         } //close if
       }//close for
     });
   }
+  RefreshDataNode(&data_node_freesyminfectchance);
   data_node_freesyminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_freesyminfectchance;
 }
@@ -943,19 +1287,17 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceD
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymInfectChanceDataNode() {
   if (!data_node_hostedsyminfectchance) {
     data_node_hostedsyminfectchance.New();
-    OnUpdate([this](size_t){
+    GetPopulationStore();
+    AddDataNodeScan({&data_node_hostedsyminfectchance}, [this](){
       data_node_hostedsyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for(size_t j=0; j< sym_size; j++){
-            data_node_hostedsyminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
+      const PopulationStore & store = GetPopulationStore();
+      // the symbiont table is grouped by host, so every hosted symbiont is one contiguous run
+      for (size_t j = 0; j < store.GetNumHostedSyms(); j++) {
+        data_node_hostedsyminfectchance->AddDatum(store.sym_infection_chance[j]);
       }//close for
     });
   }
+  RefreshDataNode(&data_node_hostedsyminfectchance);
   data_node_hostedsyminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_hostedsyminfectchance;
 }
@@ -1085,21 +1427,25 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetVerticalTransmissio
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode() {
   if (!data_node_tag_dist) {
     data_node_tag_dist.New();
-    OnUpdate([this](size_t) {
+    GetPopulationStore().PackTags();
+    SyncPopulationStore();
+    AddDataNodeScan({&data_node_tag_dist}, [this](){
       data_node_tag_dist->Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          if (pop[i]->HasSym()) {
-            emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-            for (size_t j = 0; j < symbionts.size(); j++) {
-              double distance = hamming_metric->calculate(pop[i]->GetTag(), symbionts[j]->GetTag());
-              data_node_tag_dist->AddDatum(distance);
-            }
+      const PopulationStore & store = GetPopulationStore();
+      emp::vector<uint32_t> distances;
+      for (size_t i : store.live_cells) {
+        if (store.occupied[i]) {
+          // each host's symbionts are a contiguous run of the symbiont table
+          distances.resize(store.sym_start[i+1] - store.sym_start[i]);
+          store.sym_tag_words.Distances(store.host_tag_words[i], store.sym_start[i], store.sym_start[i+1], distances.data());
+          for (uint32_t distance : distances) {
+            data_node_tag_dist->AddDatum((double) distance / TAG_LENGTH);
           }
         } //endif
       } //end for
-    }); //end OnUpdate
+    }); //end AddDataNodeScan
   } //end if
+  RefreshDataNode(&data_node_tag_dist);
   data_node_tag_dist->SetupBins(0, 1.1, 11);
   return *data_node_tag_dist;
 }
@@ -1107,17 +1453,16 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostVarianceDataNode() {
     if (!data_node_within_host_variance) {
       data_node_within_host_variance.New();
-      OnUpdate([this](size_t){
+      GetPopulationStore();
+      AddDataNodeScan({&data_node_within_host_variance}, [this](){
         data_node_within_host_variance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
+        const PopulationStore & store = GetPopulationStore();
+        for (size_t i : store.live_cells) {
+          size_t sym_size = store.GetSymCount(i);
+          if (store.occupied[i] && sym_size > 0) {
             if (sym_size > 1) { // Can't take the variance of 1 thing
-              emp::vector<double> int_vals(sym_size);
-              for(size_t j=0; j< sym_size; j++){
-                int_vals[j] = syms[j]->GetIntVal();
-              }//close for
+              auto first = store.sym_int_val.begin() + store.sym_start[i];
+              emp::vector<double> int_vals(first, first + sym_size);
               data_node_within_host_variance->AddDatum(emp::Variance(int_vals));
             } else {
               data_node_within_host_variance->AddDatum(0);
@@ -1127,27 +1472,30 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
 	      }//close for
       });
     }
+    RefreshDataNode(&data_node_within_host_variance);
     return *data_node_within_host_variance;
   }
 
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostMeanDataNode() {
     if (!data_node_within_host_mean) {
       data_node_within_host_mean.New();
-      OnUpdate([this](size_t){
+      GetPopulationStore();
+      AddDataNodeScan({&data_node_within_host_mean}, [this](){
         data_node_within_host_mean->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
-	          emp::vector<double> int_vals(sym_size);
-            for(size_t j=0; j< sym_size; j++){
-	            int_vals[j] = syms[j]->GetIntVal();
-	          }//close for
-            data_node_within_host_mean->AddDatum(emp::Mean(int_vals));
+        const PopulationStore & store = GetPopulationStore();
+        for (size_t i : store.live_cells) {
+          size_t sym_size = store.GetSymCount(i);
+          if (store.occupied[i] && sym_size > 0) {
+            double total = 0;
+            for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+              total += store.sym_int_val[j];
+            }//close for
+            data_node_within_host_mean->AddDatum(total / sym_size);
 	        }//close if
 	      }//close for
       });
     }
+    RefreshDataNode(&data_node_within_host_mean);
     return *data_node_within_host_mean;
   }
 
@@ -1164,19 +1512,26 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
   emp::DataMonitor<size_t>& SymWorld::GetHostReproCountDataNode() {
     if (!data_node_host_repro_count) {
       data_node_host_repro_count.New();
-      OnUpdate([this](size_t) {
+      auto repro_count = [](emp::Ptr<Organism> org){ return (double) org->GetReproCount(); };
+      size_t host_column = AddHostCensusColumn(repro_count);
+      size_t sym_column = AddSymCensusColumn(repro_count, false);
+      AddDataNodeScan({&data_node_host_repro_count, &data_node_sym_repro_count}, [this, host_column, sym_column](){
         data_node_host_repro_count->Reset();
         data_node_sym_repro_count->Reset();
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_repro_count->AddDatum(pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_repro_count->AddDatum(sym->GetReproCount());
+        const PopulationStore & store = GetPopulationStore();
+        const emp::vector<double> & host_repro = store.GetHostColumn(host_column);
+        const emp::vector<double> & sym_repro = store.GetHostedSymColumn(sym_column);
+        for (size_t i : store.live_cells) {
+          if (store.occupied[i] && store.host_is_host[i]) {
+            data_node_host_repro_count->AddDatum((size_t) host_repro[i]);
+            for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+              data_node_sym_repro_count->AddDatum((size_t) sym_repro[j]);
             }
           }
         }
       });
     }
+    RefreshDataNode(&data_node_host_repro_count);
     return *data_node_host_repro_count;
   }
 
@@ -1194,6 +1549,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_sym_repro_count) {
       data_node_sym_repro_count.New();
     }
+    RefreshDataNode(&data_node_sym_repro_count);
     return *data_node_sym_repro_count;
   }
 
@@ -1210,24 +1566,37 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
   emp::DataMonitor<double>& SymWorld::GetHostTowardsPartnerRateDataNode() {
     if (!data_node_host_towards_partner_rate) {
       data_node_host_towards_partner_rate.New();
-      OnUpdate([this](size_t) {
+      auto towards_rate = [](emp::Ptr<Organism> org){ return (double)org->GetTowardsPartnerCount() / (double)org->GetReproCount(); };
+      auto from_rate = [](emp::Ptr<Organism> org){ return (double)org->GetFromPartnerCount() / (double)org->GetReproCount(); };
+      size_t host_towards_column = AddHostCensusColumn(towards_rate);
+      size_t host_from_column = AddHostCensusColumn(from_rate);
+      size_t sym_towards_column = AddSymCensusColumn(towards_rate, false);
+      size_t sym_from_column = AddSymCensusColumn(from_rate, false);
+      AddDataNodeScan({&data_node_host_towards_partner_rate, &data_node_host_from_partner_rate, &data_node_sym_towards_partner_rate, &data_node_sym_from_partner_rate},
+        [this, host_towards_column, host_from_column, sym_towards_column, sym_from_column](){
         data_node_host_towards_partner_rate->Reset();
         data_node_host_from_partner_rate->Reset();
         data_node_sym_towards_partner_rate->Reset();
         data_node_sym_from_partner_rate->Reset();
 
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_towards_partner_rate->AddDatum((double)pop[i]->GetTowardsPartnerCount() / (double)pop[i]->GetReproCount());
-            data_node_host_from_partner_rate->AddDatum((double)pop[i]->GetFromPartnerCount() / (double)pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_towards_partner_rate->AddDatum((double)sym->GetTowardsPartnerCount() / (double)sym->GetReproCount());
-              data_node_sym_from_partner_rate->AddDatum((double)sym->GetFromPartnerCount() / (double)sym->GetReproCount());
+        const PopulationStore & store = GetPopulationStore();
+        const emp::vector<double> & host_towards = store.GetHostColumn(host_towards_column);
+        const emp::vector<double> & host_from = store.GetHostColumn(host_from_column);
+        const emp::vector<double> & sym_towards = store.GetHostedSymColumn(sym_towards_column);
+        const emp::vector<double> & sym_from = store.GetHostedSymColumn(sym_from_column);
+        for (size_t i : store.live_cells) {
+          if (store.occupied[i] && store.host_is_host[i]) {
+            data_node_host_towards_partner_rate->AddDatum(host_towards[i]);
+            data_node_host_from_partner_rate->AddDatum(host_from[i]);
+            for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+              data_node_sym_towards_partner_rate->AddDatum(sym_towards[j]);
+              data_node_sym_from_partner_rate->AddDatum(sym_from[j]);
             }
           }
         }
         });
     }
+    RefreshDataNode(&data_node_host_towards_partner_rate);
     return *data_node_host_towards_partner_rate;
   }
 
@@ -1245,6 +1614,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_host_from_partner_rate) {
       data_node_host_from_partner_rate.New();
     }
+    RefreshDataNode(&data_node_host_from_partner_rate);
     return *data_node_host_from_partner_rate;
   }
 
@@ -1261,6 +1631,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_sym_towards_partner_rate) {
       data_node_sym_towards_partner_rate.New();
     }
+    RefreshDataNode(&data_node_sym_towards_partner_rate);
     return *data_node_sym_towards_partner_rate;
   }
 
@@ -1277,6 +1648,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_sym_from_partner_rate) {
       data_node_sym_from_partner_rate.New();
     }
+    RefreshDataNode(&data_node_sym_from_partner_rate);
     return *data_node_sym_from_partner_rate;
   }
 
@@ -1292,29 +1664,26 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
   emp::DataMonitor<int>& SymWorld::GetHostTagRichness() {
     if (!data_node_host_tag_richness) {
       data_node_host_tag_richness.New();
-      OnUpdate([this](size_t) {
-        emp::vector<emp::BitSet<TAG_LENGTH>> host_tags;
-        emp::vector<emp::BitSet<TAG_LENGTH>> symbiont_tags;
-        data_node_host_tag_richness->Reset();
+      // the scan fills all four tag diversity nodes, so they must all exist
+      GetHostTagShannonDiversity();
+      GetSymbiontTagRichness();
+      GetSymbiontTagShannonDiversity();
+      // the tag frequencies are kept up to date as the world changes, so
+      // reading them doesn't need a scan of the population
+      TrackTagFrequencies();
+      AddDataNodeScan({&data_node_host_tag_richness, &data_node_host_tag_shannon, &data_node_symbiont_tag_richness, &data_node_symbiont_tag_shannon}, [this](){
+          data_node_host_tag_richness->Reset();
         data_node_host_tag_shannon->Reset();
         data_node_symbiont_tag_richness->Reset();
         data_node_symbiont_tag_shannon->Reset();
 
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            host_tags.push_back(pop[i]->GetTag());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              symbiont_tags.push_back(sym->GetTag());
-            }
-          }
-        }
-
-        data_node_host_tag_richness->AddDatum(emp::UniqueCount(host_tags));
-        data_node_host_tag_shannon->AddDatum(emp::ShannonEntropy(host_tags));
-        data_node_symbiont_tag_richness->AddDatum(emp::UniqueCount(symbiont_tags));
-        data_node_symbiont_tag_shannon->AddDatum(emp::ShannonEntropy(symbiont_tags));
+        data_node_host_tag_richness->AddDatum(host_tag_frequencies.GetRichness());
+        data_node_host_tag_shannon->AddDatum(host_tag_frequencies.GetShannonEntropy());
+        data_node_symbiont_tag_richness->AddDatum(sym_tag_frequencies.GetRichness());
+        data_node_symbiont_tag_shannon->AddDatum(sym_tag_frequencies.GetShannonEntropy());
         });
     }
+    RefreshDataNode(&data_node_host_tag_richness);
     return *data_node_host_tag_richness;
   }
 
@@ -1331,6 +1700,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_host_tag_shannon) {
       data_node_host_tag_shannon.New();
     }
+    RefreshDataNode(&data_node_host_tag_shannon);
     return *data_node_host_tag_shannon;
   }
 
@@ -1347,6 +1717,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_symbiont_tag_richness) {
       data_node_symbiont_tag_richness.New();
     }
+    RefreshDataNode(&data_node_symbiont_tag_richness);
     return *data_node_symbiont_tag_richness;
   }
 
@@ -1363,6 +1734,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
     if (!data_node_symbiont_tag_shannon) {
       data_node_symbiont_tag_shannon.New();
     }
+    RefreshDataNode(&data_node_symbiont_tag_shannon);
     return *data_node_symbiont_tag_shannon;
   }
   
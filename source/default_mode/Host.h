@@ -6,6 +6,7 @@
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
 #include <string>
+#include <type_traits>
 #include "../Organism.h"
 #include "SymWorld.h"
 
@@ -62,7 +63,7 @@ protected:
     * added with AddSymbiont(). This can be cleared with ClearSyms()
     *
   */
-  emp::vector<emp::Ptr<Organism>> syms = {};
+  SymbiontList syms = {};
 
   /**
     *
@@ -70,7 +71,7 @@ protected:
     * Symbionts can be added with AddReproSym(). This can be cleared with ClearSyms()
     *
   */
-  emp::vector<emp::Ptr<Organism>> repro_syms = {};
+  SymbiontList repro_syms = {};
 
   /**
     *
@@ -93,7 +94,7 @@ protected:
     * Purpose: Represents an instance of random.
     *
   */
-  emp::Ptr<emp::Random> random = NULL;
+  OrgRandomPtr random;
 
   /**
     *
@@ -116,6 +117,15 @@ protected:
   */
   bool dead = false;
 
+  /**
+    *
+    * Purpose: Represents if a host is placed in the world, so that changes to
+    * its symbionts are reported to the world's population counts. The world
+    * sets this when the host is placed and clears it when the host is removed.
+    *
+  */
+  bool in_world = false;
+
   /**
     *
     * Purpose: Represents the tag for this organism
@@ -327,21 +337,21 @@ public:
 /**
   * Input: None
   *
-  * Output: A vector of pointers to the organisms that are the host's syms.
+  * Output: The list of pointers to the organisms that are the host's syms.
   *
-  * Purpose: To get the vector containing pointers to the host's symbionts.
+  * Purpose: To get the list containing pointers to the host's symbionts.
   */
-  emp::vector<emp::Ptr<Organism>>& GetSymbionts() {return syms;}
+  SymbiontList& GetSymbionts() {return syms;}
 
 
 /**
  * Input: None
  *
- * Output: A vector of pointers to the organisms that are the host's repro syms.
+ * Output: The list of pointers to the organisms that are the host's repro syms.
  *
- * Purpose: To get the vector containing pointers to the host's repro syms.
+ * Purpose: To get the list containing pointers to the host's repro syms.
  */
-  emp::vector<emp::Ptr<Organism>>& GetReproSymbionts() {return repro_syms;}
+  SymbiontList& GetReproSymbionts() {return repro_syms;}
 
 
   /**
@@ -422,7 +432,60 @@ public:
    *
    * Purpose: To clear a host's symbionts.
    */
-  void ClearSyms() {syms.resize(0);}
+  void ClearSyms() {
+    size_t old_count = syms.size();
+    for (emp::Ptr<Organism> sym : syms) ReportSymTag(sym, false);
+    syms.clear();
+    ReportSymCountChange(old_count);
+  }
+
+
+  /**
+   * Input: A bool representing whether the host is placed in the world.
+   *
+   * Output: None
+   *
+   * Purpose: To set whether changes to the host's symbionts are reported to the world.
+   */
+  void SetInWorld(bool _in) {in_world = _in;}
+
+
+  /**
+   * Input: None
+   *
+   * Output: Whether the host is placed in the world.
+   *
+   * Purpose: To let the host's symbionts know whether their changes are counted by the world.
+   */
+  bool IsInWorld() {return in_world;}
+
+
+  /**
+   * Input: The number of symbionts the host had before its symbionts changed.
+   *
+   * Output: None
+   *
+   * Purpose: To keep the world's hosted symbiont and uninfected host counts
+   * up to date, if the host is placed in the world.
+   */
+  void ReportSymCountChange(size_t old_count) {
+    if (in_world && my_world && old_count != syms.size()) {
+      my_world->CountHostedSymChange(old_count, syms.size());
+    }
+  }
+
+
+  /**
+   * Input: A symbiont that has joined or left the host, and which of the two happened.
+   *
+   * Output: None
+   *
+   * Purpose: To keep the world's symbiont tag frequencies up to date, if the
+   * host is placed in the world.
+   */
+  void ReportSymTag(emp::Ptr<Organism> sym, bool added) {
+    if (in_world && my_world) my_world->CountSymTag(sym->GetTag(), added);
+  }
 
 
   /**
@@ -432,7 +495,7 @@ public:
    *
    * Purpose: To clear a host's repro symbionts.
    */
-  void ClearReproSyms() {repro_syms.resize(0);}
+  void ClearReproSyms() {repro_syms.clear();}
 
   /**
    * Input: The new tag
@@ -566,14 +629,21 @@ public:
       // if there's more than one sym, randomly choose one to replace, otherwise replace the one sym
       const int new_sym_pos = (syms.size() > 1) ? random->GetInt(syms.size()) : 0;
       emp::Ptr<Organism> old_sym = syms[new_sym_pos];
+      ReportSymTag(old_sym, false);
       my_world->SendToGraveyard(old_sym);
       syms[new_sym_pos] = _in;
+      ReportSymTag(_in, true);
       _in->SetHost(this);
       _in->UponInjection();
       return new_sym_pos+1;
     }
     else if((int)syms.size() < my_config->SYM_LIMIT() && allowed_in){
+      // the first time the symbionts outgrow the list's inline storage, make
+      // room for as many as the host can ever hold
+      if (syms.size() == syms.capacity()) syms.reserve(my_config->SYM_LIMIT());
       syms.push_back(_in);
+      ReportSymCountChange(syms.size() - 1);
+      ReportSymTag(_in, true);
       _in->SetHost(this);
       _in->UponInjection();
       return syms.size();
@@ -641,6 +711,62 @@ public:
     return new_host;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the host's state to a checkpoint, along with its
+   * symbionts and the symbiont offspring it is holding.
+   */
+  void WriteState(CheckpointWriter & out) {
+    out.Write(interaction_val);
+    out.Write(age);
+    out.Write(reproductions);
+    out.Write(towards_partner_count);
+    out.Write(from_partner_count);
+    out.Write(points);
+    out.Write(res_in_process);
+    out.Write(dead);
+    out.WriteBits(tag);
+    for (SymbiontList * list : {&syms, &repro_syms}) {
+      out.Write((uint64_t) list->size());
+      for (emp::Ptr<Organism> sym : *list) {
+        out.WriteString(sym->GetName());
+        sym->WriteState(out);
+      }
+    }
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved into a newly
+   * constructed host, recreating its symbionts through the world.
+   */
+  void ReadState(CheckpointReader & in) {
+    in.Read(interaction_val);
+    in.Read(age);
+    in.Read(reproductions);
+    in.Read(towards_partner_count);
+    in.Read(from_partner_count);
+    in.Read(points);
+    in.Read(res_in_process);
+    in.Read(dead);
+    in.ReadBits(tag);
+    for (SymbiontList * list : {&syms, &repro_syms}) {
+      size_t count = in.Read<uint64_t>();
+      for (size_t i = 0; i < count; i++) {
+        emp::Ptr<Organism> sym = my_world->NewCheckpointOrg(in.ReadString());
+        sym->ReadState(in);
+        if (list == &syms) sym->SetHost(this);
+        list->push_back(sym);
+      }
+    }
+  }
+
   /**
    * Input: None.
    *
@@ -681,6 +807,7 @@ public:
    * hosts to allow for evolution to occur.
    */
   void Mutate(){
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     double mutation_size = my_config->HOST_MUTATION_SIZE();
     if (mutation_size == -1) mutation_size = my_config->MUTATION_SIZE();
     double mutation_rate = my_config->HOST_MUTATION_RATE();
@@ -708,6 +835,20 @@ public:
    * is split into equal chunks for each symbiont
    */
   void DistribResources(double resources) {
+    DistribResourcesAs<Organism, Organism>(resources);
+  }
+
+  /**
+   * Input: The double representing the number of resources to be distributed to the host and its symbionts.
+   *
+   * Output: None
+   *
+   * Purpose: The body of DistribResources(), with the host and symbiont types fixed at compile time
+   * so the symbionts' resource processing can be inlined. Organism for either type means its calls
+   * go through the vtable.
+   */
+  template <typename HOST_T, typename SYM_T>
+  void DistribResourcesAs(double resources) {
     double hostIntVal = interaction_val; //using private variable because we can
     //do ectosymbiosis if the config setting is on, there is a parallel sym
 
@@ -729,7 +870,7 @@ public:
     double sym_piece = (double) resources / num_sym;
 
     for(size_t i=0; i < syms.size(); i++){
-      DistribResToSym(syms[i], sym_piece);
+      DistribResToSym<HOST_T, SYM_T>(syms[i], sym_piece);
     }
   } //end DistribResources
 
@@ -738,13 +879,14 @@ public:
    *
    * Output: The resources remaining after the host maybe does ectosymbiosis.
    *
-   * Purpose: To handle ectosymbiosis.
+   * Purpose: To handle ectosymbiosis. HOST_T and SYM_T are as in DistribResToSym().
    */
+  template <typename HOST_T = Organism, typename SYM_T = Organism>
   double HandleEctosymbiosis(double resources, size_t location){
     double leftover_resources = resources;
     if(GetDoEctosymbiosis(location)){
       double sym_piece = leftover_resources / (syms.size() + 1); //if there are no endo syms, the ecto sym will handle all the resources
-      DistribResToSym(my_world->GetSymAt(location), sym_piece);
+      DistribResToSym<HOST_T, SYM_T>(my_world->GetSymAt(location), sym_piece);
       leftover_resources = leftover_resources - sym_piece; //leave the leftover resources to be split by other syms
     }
     return leftover_resources;
@@ -773,7 +915,10 @@ public:
    * Output: None
    *
    * Purpose: To distribute resources between sym and host depending on their interaction values.
+   * When HOST_T and SYM_T are the exact types of this host and the sym, the sym's resource processing
+   * (and its StealResources() call back into this host) is called directly instead of through the vtable.
    */
+  template <typename HOST_T = Organism, typename SYM_T = Organism>
   void DistribResToSym(emp::Ptr<Organism> sym, double sym_piece){
     double host_int_val = interaction_val;
     double host_donation = 0;
@@ -786,7 +931,12 @@ public:
       host_donation = host_int_val * sym_piece;
       SetResInProcess(sym_piece - host_donation);
     }
-    double sym_return = sym->ProcessResources(host_donation, this);
+    double sym_return;
+    if constexpr (std::is_same_v<SYM_T, Organism>) sym_return = sym->ProcessResources(host_donation, this);
+    else {
+      emp_assert(typeid(*sym) == typeid(SYM_T));
+      sym_return = static_cast<SYM_T *>(sym.Raw())->template ProcessResourcesFrom<HOST_T>(host_donation, static_cast<HOST_T *>(this));
+    }
     this->AddPoints(sym_return + GetResInProcess());
     SetResInProcess(0);
   }
@@ -801,12 +951,34 @@ public:
    * transmission, removing dead syms, and processing alive syms.
    */
   void Process(emp::WorldPosition pos) {
+    if (my_config->ECTOSYMBIOSIS()) ProcessKernel<true>(pos);
+    else ProcessKernel<false>(pos);
+  }
+
+  /**
+   * Input: The size_t value representing the location of the host.
+   *
+   * Output: None
+   *
+   * Purpose: The body of Process(), with the ECTOSYMBIOSIS setting fixed at
+   * compile time. SymWorld calls the right variant directly once it has
+   * resolved the setting for the update. When HOST_T and SYM_T are given,
+   * they must be the exact types of this host and all of its symbionts; the
+   * symbionts are then processed as SYM_T with FREE_LIVING_SYMS fixed too,
+   * and none of their calls go through the vtable.
+   */
+  template <bool ECTOSYMBIOSIS, typename HOST_T = Organism, typename SYM_T = Organism, bool FREE_LIVING_SYMS = false>
+  void ProcessKernel(emp::WorldPosition pos) {
     size_t location = pos.GetIndex();
     //Currently just wrapping to use the existing function
     double desired_resources = my_config->RES_DISTRIBUTE();
     double world_resources = my_world->PullResources(desired_resources); //receive resources from the world
-    double resources = HandleEctosymbiosis(world_resources, location);
-    if(resources > 0) DistribResources(resources); //if there are enough resources left, distribute them.
+    double resources = world_resources;
+    if constexpr (ECTOSYMBIOSIS) resources = HandleEctosymbiosis<HOST_T, SYM_T>(world_resources, location);
+    if(resources > 0) { //if there are enough resources left, distribute them.
+      if constexpr (std::is_same_v<HOST_T, Organism>) DistribResources(resources);
+      else static_cast<HOST_T *>(this)->template DistribResourcesAs<HOST_T, SYM_T>(resources);
+    }
 
     // Check reproduction
     if (GetPoints() >= my_config->HOST_REPRO_RES() && repro_syms.size() == 0) {  // if host has more points than required for repro
@@ -825,7 +997,7 @@ public:
         return; //If host is dead, return
       }
     if (HasSym()) { //let each sym do whatever they need to do
-        emp::vector<emp::Ptr<Organism>>& syms = GetSymbionts();
+        SymbiontList& syms = GetSymbionts();
         for(size_t j = 0; j < syms.size(); j++){
           emp::Ptr<Organism> cur_sym = syms[j];
           if (GetDead()){
@@ -835,12 +1007,27 @@ public:
           //position in syms list + 1 as index (0 as fls index)
           emp::WorldPosition sym_pos = emp::WorldPosition(j+1, location);
           if(!cur_sym->GetDead()){
-              cur_sym->Process(sym_pos);
+              OrgRandomPtr::SetSlot(j+1);
+              if constexpr (std::is_same_v<SYM_T, Organism>) cur_sym->Process(sym_pos);
+              else {
+                emp_assert(typeid(*cur_sym) == typeid(SYM_T));
+                static_cast<SYM_T *>(cur_sym.Raw())->template ProcessKernel<FREE_LIVING_SYMS>(sym_pos);
+              }
+              OrgRandomPtr::SetSlot(0);
           }
           if(cur_sym->GetDead()) {
             //if the symbiont dies during their process, remove from syms list
             //UNLESS they died by getting ousted
-            syms.erase(syms.begin() + j); 
+            if (my_config->KEEP_SYM_ORDER()) {
+              syms.erase(syms.begin() + j);
+            } else {
+              //the last sym takes this one's place, and is processed next
+              syms.SwapRemove(j);
+              j--;
+            }
+            ReportSymCountChange(syms.size() + 1);
+            ReportSymTag(cur_sym, false);
+            SYM_PROFILE_COUNT(DEATHS);
             cur_sym.Delete();
           }
         } //for each sym in syms
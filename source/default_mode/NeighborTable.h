@@ -0,0 +1,105 @@
+#ifndef NEIGHBOR_TABLE_H
+#define NEIGHBOR_TABLE_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+
+#include <bit>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents the neighbors of every cell of a toroidal grid, worked
+ * out once so that finding a neighbor is a table lookup rather than two
+ * divisions and two modulos.
+ *
+ * Each cell has its Moore neighborhood, the 3x3 block centred on it in
+ * row-major order (so the cell itself is entry CENTER), and its von Neumann
+ * neighborhood, the cells above, left, right and below it. On grids less
+ * than three cells wide or tall, some entries name the same cell, just as
+ * the wrapped coordinates would.
+ *
+ */
+class NeighborTable {
+public:
+  static constexpr size_t MOORE_SIZE = 9;
+  static constexpr size_t CENTER = 4;
+  static constexpr size_t VON_NEUMANN_SIZE = 4;
+
+private:
+  size_t width = 0;
+  size_t height = 0;
+  emp::vector<uint32_t> moore;
+  emp::vector<uint32_t> von_neumann;
+
+public:
+  /**
+   * Input: The width and height of the grid.
+   *
+   * Output: None
+   *
+   * Purpose: To work out the neighbors of every cell of a grid.
+   */
+  void Build(size_t _width, size_t _height) {
+    width = _width;
+    height = _height;
+    moore.resize(width * height * MOORE_SIZE);
+    von_neumann.resize(width * height * VON_NEUMANN_SIZE);
+    for (size_t y = 0; y < height; y++) {
+      for (size_t x = 0; x < width; x++) {
+        const size_t cell = x + y * width;
+        for (size_t offset = 0; offset < MOORE_SIZE; offset++) {
+          const size_t neighbor_x = (x + width + offset % 3 - 1) % width;
+          const size_t neighbor_y = (y + height + offset / 3 - 1) % height;
+          moore[cell * MOORE_SIZE + offset] = (uint32_t) (neighbor_x + neighbor_y * width);
+        }
+        // the von Neumann neighbors are the Moore block's edge midpoints
+        for (size_t side = 0; side < VON_NEUMANN_SIZE; side++) {
+          von_neumann[cell * VON_NEUMANN_SIZE + side] = moore[cell * MOORE_SIZE + 2 * side + 1];
+        }
+      }
+    }
+  }
+
+  bool Fits(size_t _width, size_t _height) const { return width == _width && height == _height; }
+  size_t GetWidth() const { return width; }
+  size_t GetHeight() const { return height; }
+
+  // the cell's Moore neighborhood, MOORE_SIZE cells in row-major order
+  const uint32_t * GetMoore(size_t cell) const { return moore.data() + cell * MOORE_SIZE; }
+  // the cells above, left of, right of and below the cell
+  const uint32_t * GetVonNeumann(size_t cell) const { return von_neumann.data() + cell * VON_NEUMANN_SIZE; }
+  uint32_t GetMooreNeighbor(size_t cell, size_t offset) const { return moore[cell * MOORE_SIZE + offset]; }
+
+  /**
+   * Input: A cell, and a function telling whether a cell is occupied.
+   *
+   * Output: A mask with bit i set if the cell's Moore neighbor at offset i
+   * is occupied. The cell itself (bit CENTER) is never set.
+   *
+   * Purpose: To find a cell's occupied neighbors without listing them.
+   */
+  template <typename OCCUPIED_T>
+  uint32_t GetOccupiedMask(size_t cell, OCCUPIED_T && occupied) const {
+    const uint32_t * neighbors = GetMoore(cell);
+    uint32_t mask = 0;
+    for (size_t offset = 0; offset < MOORE_SIZE; offset++) {
+      if (offset != CENTER && occupied(neighbors[offset])) mask |= 1u << offset;
+    }
+    return mask;
+  }
+
+  /**
+   * Input: A mask of offsets, and which of its set bits to take, counting
+   * from the lowest.
+   *
+   * Output: The offset of that bit.
+   *
+   * Purpose: To turn a random pick among a mask's set bits into an offset.
+   */
+  static size_t NthOffset(uint32_t mask, size_t n) {
+    for (; n > 0; n--) mask &= mask - 1;
+    return std::countr_zero(mask);
+  }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef OCCUPANCY_INDEX_H
+#define OCCUPANCY_INDEX_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ *
+ * Purpose: Represents which of a world's cells are live, meaning they hold a
+ * host, a free-living symbiont, or both. Live cells are kept in a dense list,
+ * with each cell's place in it, so a cell is added or removed in constant
+ * time and walking the live cells costs time in the number of organisms
+ * rather than the area of the world.
+ *
+ * The list is in no particular order; GetSortedCells() gives the live cells
+ * in ascending order for walks whose results depend on order, sorting them
+ * again only after the live cells have changed.
+ *
+ */
+class OccupancyIndex {
+public:
+  enum Resident : uint8_t { HOST = 1, FREE_SYM = 2 };
+
+private:
+  static constexpr size_t NOT_LIVE = (size_t) -1;
+
+  emp::vector<uint8_t> residents; // a Resident bit for each organism in the cell
+  emp::vector<size_t> cells;      // the live cells
+  emp::vector<size_t> places;     // each cell's position in cells, or NOT_LIVE
+  emp::vector<size_t> sorted_cells;
+  bool sorted_cells_stale = false; // whether cells changed since sorted_cells was built
+
+public:
+  /**
+   * Input: The number of cells in the world.
+   *
+   * Output: None
+   *
+   * Purpose: To fit the index to a resized world, forgetting any cells that
+   * no longer exist.
+   */
+  void Resize(size_t num_cells) {
+    for (size_t cell = num_cells; cell < residents.size(); cell++) {
+      Set(cell, HOST, false);
+      Set(cell, FREE_SYM, false);
+    }
+    residents.resize(num_cells, 0);
+    places.resize(num_cells, NOT_LIVE);
+  }
+
+  /**
+   * Input: The cell, which kind of organism, and whether the cell now holds one.
+   *
+   * Output: None
+   *
+   * Purpose: To record an organism being placed in or removed from a cell,
+   * adding the cell to or removing it from the live cells as needed.
+   */
+  void Set(size_t cell, Resident resident, bool present) {
+    if (cell >= residents.size()) Resize(cell + 1);
+    const uint8_t old_residents = residents[cell];
+    const uint8_t new_residents = present ? (old_residents | resident) : (old_residents & ~resident);
+    residents[cell] = new_residents;
+    if (!old_residents && new_residents) {
+      places[cell] = cells.size();
+      cells.push_back(cell);
+      sorted_cells_stale = true;
+    } else if (old_residents && !new_residents) {
+      // the last live cell takes this one's place
+      const size_t place = places[cell];
+      cells[place] = cells.back();
+      places[cells[place]] = place;
+      cells.pop_back();
+      places[cell] = NOT_LIVE;
+      sorted_cells_stale = true;
+    }
+  }
+
+  bool IsLive(size_t cell) const { return cell < residents.size() && residents[cell]; }
+  size_t GetNumLive() const { return cells.size(); }
+  size_t GetNumCells() const { return residents.size(); }
+
+  // the live cells, in no particular order; changes as organisms come and go
+  const emp::vector<size_t> & GetCells() const { return cells; }
+
+  /**
+   * Input: None
+   *
+   * Output: The live cells in ascending order. The reference stays valid
+   * until the live cells change.
+   *
+   * Purpose: To walk the live cells in the same order a scan of every cell
+   * would visit them.
+   */
+  const emp::vector<size_t> & GetSortedCells() {
+    if (sorted_cells_stale) {
+      sorted_cells = cells;
+      std::sort(sorted_cells.begin(), sorted_cells.end());
+      sorted_cells_stale = false;
+    }
+    return sorted_cells;
+  }
+};
+
+#endif
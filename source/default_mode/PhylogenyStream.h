@@ -0,0 +1,159 @@
+#ifndef PHYLOGENY_STREAM_H
+#define PHYLOGENY_STREAM_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+
+/**
+ *
+ * Purpose: Represents an append-only file of phylogeny rows that no longer
+ * change, such as the interaction counts of an extinct taxon, written once
+ * so they don't have to stay in memory until the next snapshot.
+ *
+ * AppendTo() adds the streamed rows to a snapshot written from memory,
+ * lining the columns up by name, so the result has the snapshot's format.
+ * Snapshot columns the stream doesn't know are left empty. A row stops
+ * belonging in snapshots once its taxon is pruned, so AppendTo() takes a
+ * test of which rows to keep and drops the others from the file for good.
+ *
+ */
+class PhylogenyStream {
+public:
+  using keep_fun_t = std::function<bool(const emp::vector<std::string> &)>;
+
+private:
+  std::string path;
+  emp::vector<std::string> columns;
+  std::ofstream out;
+  size_t num_rows = 0;
+
+  static std::string Trim(const std::string & text) {
+    const size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    return text.substr(start, text.find_last_not_of(" \t\r") - start + 1);
+  }
+
+  static emp::vector<std::string> Split(const std::string & line) {
+    emp::vector<std::string> fields;
+    std::stringstream line_stream(line);
+    std::string field;
+    while (std::getline(line_stream, field, ',')) fields.push_back(Trim(field));
+    if (!line.empty() && line.back() == ',') fields.push_back("");
+    return fields;
+  }
+
+public:
+  PhylogenyStream() = default;
+  PhylogenyStream(const PhylogenyStream &) = delete;
+  PhylogenyStream & operator=(const PhylogenyStream &) = delete;
+
+  /**
+   * Input: The file to stream to, and the names of the columns of each row.
+   *
+   * Output: None
+   *
+   * Purpose: To set where rows go. The file is only created (or emptied)
+   * when the first row is added.
+   */
+  void SetPath(const std::string & _path, const emp::vector<std::string> & _columns) {
+    if (out.is_open()) out.close();
+    path = _path;
+    columns = _columns;
+    num_rows = 0;
+  }
+
+  // stops streaming; the file and its rows are kept
+  void Close() {
+    if (out.is_open()) out.close();
+    path.clear();
+  }
+
+  bool IsSet() const { return !path.empty(); }
+  const std::string & GetPath() const { return path; }
+  size_t GetNumRows() const { return num_rows; }
+
+  /**
+   * Input: The row's values, separated by commas, in the order of the columns.
+   *
+   * Output: None
+   *
+   * Purpose: To add a row to the end of the file.
+   */
+  void AddRow(const std::string & row) {
+    emp_assert(IsSet(), "PhylogenyStream needs a path before rows are added");
+    if (!out.is_open()) {
+      out.open(path, std::ios::trunc);
+      if (!out) throw "Unable to open phylogeny stream file";
+      for (size_t i = 0; i < columns.size(); i++) out << (i ? "," : "") << columns[i];
+      out << '\n';
+    }
+    out << row << '\n';
+    num_rows++;
+  }
+
+  /**
+   * Input: A file that starts with a header line of column names, and a test
+   * of whether a row, split into the stream's columns, still belongs in it.
+   *
+   * Output: None
+   *
+   * Purpose: To append the streamed rows that pass the test to the file,
+   * with their values moved under the file's columns of the same name, and
+   * to drop the rows that fail it from the stream.
+   */
+  void AppendTo(const std::string & target, const keep_fun_t & keep) {
+    if (num_rows == 0) return;
+    out.flush();
+
+    std::string header;
+    {
+      std::ifstream target_in(target);
+      if (!std::getline(target_in, header)) throw "Unable to read the header of a phylogeny snapshot";
+    }
+    // for each of the target's columns, which of ours holds its value
+    emp::vector<size_t> sources;
+    for (const std::string & name : Split(header)) {
+      sources.push_back(std::find(columns.begin(), columns.end(), name) - columns.begin());
+    }
+
+    const std::string kept_path = path + ".kept";
+    size_t num_kept = 0;
+    {
+      std::ifstream in(path);
+      std::ofstream target_out(target, std::ios::app);
+      std::ofstream kept_out(kept_path, std::ios::trunc);
+      std::string line;
+      std::getline(in, line); // our header
+      kept_out << line << '\n';
+      while (std::getline(in, line)) {
+        const emp::vector<std::string> fields = Split(line);
+        if (!keep(fields)) continue;
+        for (size_t i = 0; i < sources.size(); i++) {
+          if (i) target_out << ',';
+          if (sources[i] < fields.size()) target_out << fields[sources[i]];
+        }
+        target_out << '\n';
+        kept_out << line << '\n';
+        num_kept++;
+      }
+    }
+
+    if (num_kept < num_rows) {
+      out.close();
+      std::remove(path.c_str());
+      if (std::rename(kept_path.c_str(), path.c_str()) != 0) throw "Unable to replace the phylogeny stream file";
+      out.open(path, std::ios::app);
+      num_rows = num_kept;
+    } else {
+      std::remove(kept_path.c_str());
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef POPULATION_STORE_H
+#define POPULATION_STORE_H
+
+#include "../../Empirical/include/emp/base/Ptr.hpp"
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/bits/BitSet.hpp"
+#include "../Organism.h"
+#include "../PackedTags.h"
+
+#include <cstdint>
+#include <functional>
+
+/**
+ *
+ * Purpose: Represents the state of a world's population laid out as
+ * structure-of-arrays columns. Host columns are indexed by cell; hosted
+ * symbionts are stored in one flat table, where the symbionts of the host in
+ * cell i are the rows sym_start[i] up to sym_start[i+1]. Free-living
+ * symbionts get their own per-cell columns.
+ *
+ * The organisms themselves stay the authoritative copy of their state; the
+ * store is refilled from them with Gather(), after which population-wide
+ * scans can walk contiguous memory instead of following a pointer per host
+ * and per symbiont.
+ *
+ * Gather() is the world's one census walk per sampled update. Data that only
+ * some data nodes or modes need (lysis chance, donation, repro counts, ...)
+ * is registered as an extra column with an extractor, which Gather() calls
+ * in the same walk.
+ *
+ */
+class PopulationStore {
+public:
+  using pop_t = emp::vector<emp::Ptr<Organism>>;
+  using extractor_t = std::function<double(emp::Ptr<Organism>)>;
+
+  // per-cell host columns
+  emp::vector<uint8_t> occupied;
+  emp::vector<uint8_t> host_is_host;
+  emp::vector<double> host_int_val;
+  emp::vector<double> host_points;
+  emp::vector<double> host_res_in_process;
+  emp::vector<int> host_age;
+  emp::vector<uint8_t> host_dead;
+  emp::vector<emp::BitSet<TAG_LENGTH>> host_tag;
+
+  // flat hosted symbiont table, grouped by host cell
+  emp::vector<size_t> sym_start;
+  emp::vector<double> sym_int_val;
+  emp::vector<double> sym_points;
+  emp::vector<double> sym_infection_chance;
+  emp::vector<int> sym_age;
+  emp::vector<uint8_t> sym_dead;
+  emp::vector<emp::BitSet<TAG_LENGTH>> sym_tag;
+
+  // per-cell free-living symbiont columns
+  emp::vector<uint8_t> free_sym_present;
+  emp::vector<double> free_sym_int_val;
+  emp::vector<double> free_sym_infection_chance;
+
+  // packed copies of host_tag and sym_tag for batched tag distances, only
+  // filled after PackTags()
+  PackedTags<TAG_LENGTH> host_tag_words;
+  PackedTags<TAG_LENGTH> sym_tag_words;
+
+  // the cells holding a host or a free-living symbiont, in ascending order;
+  // the columns of other cells may be out of date after a sparse Gather()
+  emp::vector<size_t> live_cells;
+
+private:
+  size_t num_hosts = 0;
+  size_t num_free_syms = 0;
+  bool pack_tags = false;
+
+  // registered extra columns
+  emp::vector<extractor_t> host_extractors;
+  emp::vector<extractor_t> sym_extractors;
+  emp::vector<bool> sym_extractor_free;
+  emp::vector<emp::vector<double>> host_columns;
+  emp::vector<emp::vector<double>> hosted_sym_columns;
+  emp::vector<emp::vector<double>> free_sym_columns;
+
+  /**
+   * Input: The number of cells in the world.
+   *
+   * Output: None
+   *
+   * Purpose: To size the per-cell columns and empty the symbiont table,
+   * keeping the capacity of every column so refills don't reallocate.
+   */
+  void ResizeCells(size_t num_cells) {
+    occupied.resize(num_cells);
+    host_is_host.resize(num_cells);
+    host_int_val.resize(num_cells);
+    host_points.resize(num_cells);
+    host_res_in_process.resize(num_cells);
+    host_age.resize(num_cells);
+    host_dead.resize(num_cells);
+    host_tag.resize(num_cells);
+    if (pack_tags) host_tag_words.resize(num_cells);
+    sym_start.resize(num_cells + 1);
+    free_sym_present.resize(num_cells);
+    free_sym_int_val.resize(num_cells);
+    free_sym_infection_chance.resize(num_cells);
+    for (emp::vector<double> & column : host_columns) column.resize(num_cells);
+    for (emp::vector<double> & column : free_sym_columns) column.resize(num_cells);
+
+    sym_int_val.clear();
+    sym_points.clear();
+    sym_infection_chance.clear();
+    sym_age.clear();
+    sym_dead.clear();
+    sym_tag.clear();
+    sym_tag_words.clear();
+    for (emp::vector<double> & column : hosted_sym_columns) column.clear();
+  }
+
+  /**
+   * Input: The symbiont to copy into the hosted symbiont table.
+   *
+   * Output: None
+   *
+   * Purpose: To append one row to the hosted symbiont table.
+   */
+  void AddSymRow(emp::Ptr<Organism> sym) {
+    sym_int_val.push_back(sym->GetIntVal());
+    sym_points.push_back(sym->GetPoints());
+    sym_infection_chance.push_back(sym->GetInfectionChance());
+    sym_age.push_back(sym->GetAge());
+    sym_dead.push_back(sym->GetDead());
+    sym_tag.push_back(sym->GetTag());
+    if (pack_tags) sym_tag_words.push_back(sym->GetTag());
+    for (size_t c = 0; c < sym_extractors.size(); c++) {
+      hosted_sym_columns[c].push_back(sym_extractors[c](sym));
+    }
+  }
+
+  /**
+   * Input: The cell to copy, and the world's populations.
+   *
+   * Output: None
+   *
+   * Purpose: To copy the host, hosted symbionts and free-living symbiont of
+   * one cell into the columns, appending its symbionts to the table.
+   */
+  void GatherCell(size_t i, const pop_t & pop, const pop_t & sym_pop, bool has_free_syms) {
+    sym_start[i] = sym_int_val.size();
+    emp::Ptr<Organism> host = pop[i];
+    occupied[i] = (bool) host;
+    if (host) {
+      num_hosts++;
+      host_int_val[i] = host->GetIntVal();
+      host_points[i] = host->GetPoints();
+      host_res_in_process[i] = host->GetResInProcess();
+      host_age[i] = host->GetAge();
+      host_dead[i] = host->GetDead();
+      host_tag[i] = host->GetTag();
+      if (pack_tags) host_tag_words.Set(i, host->GetTag());
+      host_is_host[i] = host->IsHost();
+      for (size_t c = 0; c < host_extractors.size(); c++) {
+        host_columns[c][i] = host_extractors[c](host);
+      }
+      for (emp::Ptr<Organism> sym : host->GetSymbionts()) AddSymRow(sym);
+    }
+
+    emp::Ptr<Organism> free_sym = has_free_syms ? sym_pop[i] : nullptr;
+    free_sym_present[i] = (bool) free_sym;
+    if (free_sym) {
+      num_free_syms++;
+      free_sym_int_val[i] = free_sym->GetIntVal();
+      free_sym_infection_chance[i] = free_sym->GetInfectionChance();
+      for (size_t c = 0; c < sym_extractors.size(); c++) {
+        if (sym_extractor_free[c]) free_sym_columns[c][i] = sym_extractors[c](free_sym);
+      }
+    }
+    sym_start[i + 1] = sym_int_val.size();
+  }
+
+public:
+  /**
+   * Input: The world's host population and free-living symbiont population.
+   * The symbiont population is either empty or the same size as the host
+   * population.
+   *
+   * Output: None
+   *
+   * Purpose: To refill every column from the organisms in one pass.
+   */
+  void Gather(const pop_t & pop, const pop_t & sym_pop) {
+    const size_t num_cells = pop.size();
+    const bool has_free_syms = sym_pop.size() == num_cells;
+    ResizeCells(num_cells);
+    num_hosts = 0;
+    num_free_syms = 0;
+    live_cells.clear();
+
+    for (size_t i = 0; i < num_cells; i++) {
+      GatherCell(i, pop, sym_pop, has_free_syms);
+      if (occupied[i] || free_sym_present[i]) live_cells.push_back(i);
+    }
+  }
+
+  /**
+   * Input: The world's host population and free-living symbiont population,
+   * and the cells holding a host or a free-living symbiont in ascending order.
+   *
+   * Output: None
+   *
+   * Purpose: To refill the columns from the organisms, visiting only the
+   * given cells. The occupied and free_sym_present flags stay right for
+   * every cell; the other columns and sym_start are only kept up to date for
+   * the live cells, which is all the scans over live_cells read.
+   */
+  void Gather(const pop_t & pop, const pop_t & sym_pop, const emp::vector<size_t> & sorted_live_cells) {
+    const size_t num_cells = pop.size();
+    const bool has_free_syms = sym_pop.size() == num_cells;
+    ResizeCells(num_cells);
+    num_hosts = 0;
+    num_free_syms = 0;
+
+    // empty the cells that were live in the last gather
+    for (size_t i : live_cells) {
+      if (i >= num_cells) continue;
+      occupied[i] = false;
+      free_sym_present[i] = false;
+    }
+    live_cells = sorted_live_cells;
+    for (size_t i : live_cells) GatherCell(i, pop, sym_pop, has_free_syms);
+    sym_start[num_cells] = sym_int_val.size();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To have Gather() also fill the packed tag columns.
+   */
+  void PackTags() { pack_tags = true; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of cells the columns cover.
+   *
+   * Purpose: To get the number of cells in the store.
+   */
+  size_t GetNumCells() const { return occupied.size(); }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of hosts seen by the last Gather().
+   *
+   * Purpose: To get the host count without another scan.
+   */
+  size_t GetNumHosts() const { return num_hosts; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of hosted symbionts seen by the last Gather().
+   *
+   * Purpose: To get the hosted symbiont count without another scan.
+   */
+  size_t GetNumHostedSyms() const { return sym_int_val.size(); }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of free-living symbionts seen by the last Gather().
+   *
+   * Purpose: To get the free-living symbiont count without another scan.
+   */
+  size_t GetNumFreeSyms() const { return num_free_syms; }
+
+  /**
+   * Input: The cell of a host.
+   *
+   * Output: How many symbionts the host in that cell had.
+   *
+   * Purpose: To get the size of one host's block of the symbiont table.
+   */
+  size_t GetSymCount(size_t cell) const { return sym_start[cell + 1] - sym_start[cell]; }
+
+  /**
+   * Input: The function that reads the column's value from a host.
+   *
+   * Output: The id of the new host column.
+   *
+   * Purpose: To add a per-cell host column that Gather() fills from every
+   * host. Cells without a host keep stale values, so readers check occupied.
+   * The column is empty until the next Gather().
+   */
+  size_t AddHostColumn(extractor_t extractor) {
+    host_extractors.push_back(extractor);
+    host_columns.emplace_back();
+    return host_columns.size() - 1;
+  }
+
+  /**
+   * Input: The function that reads the column's value from a symbiont, and
+   * whether free-living symbionts should be read too.
+   *
+   * Output: The id of the new symbiont column.
+   *
+   * Purpose: To add a symbiont column that Gather() fills from every hosted
+   * symbiont (one value per row of the hosted symbiont table) and, if asked,
+   * from every free-living symbiont (one value per cell). The column is empty
+   * until the next Gather().
+   */
+  size_t AddSymColumn(extractor_t extractor, bool free_living = true) {
+    sym_extractors.push_back(extractor);
+    sym_extractor_free.push_back(free_living);
+    hosted_sym_columns.emplace_back();
+    free_sym_columns.emplace_back();
+    return hosted_sym_columns.size() - 1;
+  }
+
+  /**
+   * Input: The id of a host column.
+   *
+   * Output: The column's value for each cell.
+   *
+   * Purpose: To read a column added with AddHostColumn().
+   */
+  const emp::vector<double> & GetHostColumn(size_t id) const { return host_columns[id]; }
+
+  /**
+   * Input: The id of a symbiont column.
+   *
+   * Output: The column's value for each row of the hosted symbiont table.
+   *
+   * Purpose: To read the hosted half of a column added with AddSymColumn().
+   */
+  const emp::vector<double> & GetHostedSymColumn(size_t id) const { return hosted_sym_columns[id]; }
+
+  /**
+   * Input: The id of a symbiont column.
+   *
+   * Output: The column's value for each cell holding a free-living symbiont.
+   *
+   * Purpose: To read the free-living half of a column added with
+   * AddSymColumn().
+   */
+  const emp::vector<double> & GetFreeSymColumn(size_t id) const { return free_sym_columns[id]; }
+};
+
+#endif
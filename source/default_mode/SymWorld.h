@@ -8,10 +8,144 @@
 #include "../../Empirical/include/emp/math/Random.hpp"
 #include "../../Empirical/include/emp/matching/MatchBin.hpp"
 
+#include "../Checkpoint.h"
+#include "../ColumnarDataFile.h"
 #include "../Organism.h"
+#include "../KeyedRandom.h"
+#include "../PackedTags.h"
+#include "../PoissonTable.h"
+#include "../RandomPool.h"
+#include "../UpdateProfiler.h"
+#include "../WorkerPool.h"
+#include "NeighborTable.h"
+#include "OccupancyIndex.h"
+#include "PhylogenyStream.h"
+#include "PopulationStore.h"
+#include "TagFrequencyTable.h"
+#include "UpdateScheduler.h"
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
 #include <set>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
 #include <math.h>
 
+/**
+ *
+ * Purpose: Represents an organism's handle on its random number generator.
+ * While a SymWorld is processing grid tiles in parallel, each worker thread
+ * installs the generator of the tile it is working on, and every draw made
+ * on that thread goes to the tile's generator instead of the organism's own.
+ * When RANDOM_POOL is on, the world also installs the random number pool of
+ * the tile (or the whole world) being processed, and the draws the pool
+ * covers come from it instead. When KEYED_RANDOM is on, the world installs
+ * the keyed generator of the thread instead, and every draw comes from the
+ * address of the cell, organism slot and purpose being processed.
+ *
+ * Organisms draw through it with the same calls as an emp::Random, as in
+ * random->GetDouble(0.0, 1.0).
+ *
+ */
+class OrgRandomPtr {
+private:
+  emp::Ptr<emp::Random> random = nullptr;
+
+  emp::Random & Source() const { return tile_random ? *tile_random : *random; }
+
+public:
+  /**
+    *
+    * Purpose: Represents the generator of the tile this thread is processing,
+    * or nullptr outside of a parallel tile update.
+    *
+  */
+  static inline thread_local emp::Ptr<emp::Random> tile_random = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the random number pool organisms processed on this
+    * thread draw from, or nullptr if they draw from their generator directly.
+    *
+  */
+  static inline thread_local emp::Ptr<RandomPool> pool = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the keyed generator organisms processed on this
+    * thread draw from, or nullptr if KEYED_RANDOM is off.
+    *
+  */
+  static inline thread_local emp::Ptr<KeyedRandom> keyed = nullptr;
+
+  /**
+   * Input: The slot of the organism about to be processed in its cell.
+   *
+   * Output: None
+   *
+   * Purpose: To address the following keyed draws to that organism, if
+   * KEYED_RANDOM is on.
+   */
+  static void SetSlot(uint32_t slot) {
+    if (keyed) keyed->SetAddress(slot, KeyedRandom::GENERAL);
+  }
+
+  /**
+    *
+    * Purpose: Represents a stretch of code whose keyed draws have their own
+    * purpose, such as mutating offspring, restoring the previous purpose when
+    * it ends. It does nothing if KEYED_RANDOM is off.
+    *
+  */
+  class PurposeScope {
+  private:
+    KeyedRandom::Purpose outer = KeyedRandom::GENERAL;
+
+  public:
+    PurposeScope(KeyedRandom::Purpose purpose) {
+      if (!keyed) return;
+      outer = keyed->GetPurpose();
+      keyed->SetAddress(keyed->GetSlot(), purpose);
+    }
+    ~PurposeScope() {
+      if (keyed) keyed->SetAddress(keyed->GetSlot(), outer);
+    }
+  };
+
+  OrgRandomPtr() = default;
+  OrgRandomPtr(emp::Ptr<emp::Random> _random) : random(_random) {}
+
+  const OrgRandomPtr * operator->() const { return this; }
+
+  double GetDouble() const { return keyed ? keyed->GetDouble() : pool ? pool->GetDouble() : Source().GetDouble(); }
+  double GetDouble(double max) const { return keyed ? keyed->GetDouble(max) : pool ? pool->GetDouble(max) : Source().GetDouble(max); }
+  double GetDouble(double min, double max) const { return keyed ? keyed->GetDouble(min, max) : pool ? pool->GetDouble(min, max) : Source().GetDouble(min, max); }
+  uint32_t GetUInt(uint32_t max) const { return keyed ? keyed->GetUInt(max) : pool ? pool->GetUInt(max) : Source().GetUInt(max); }
+  uint32_t GetUInt(uint32_t min, uint32_t max) const { return keyed ? keyed->GetUInt(min, max) : pool ? pool->GetUInt(min, max) : Source().GetUInt(min, max); }
+  int GetInt(int max) const { return keyed ? keyed->GetInt(max) : pool ? pool->GetInt(max) : Source().GetInt(max); }
+  int GetInt(int min, int max) const { return keyed ? keyed->GetInt(min, max) : pool ? pool->GetInt(min, max) : Source().GetInt(min, max); }
+  bool P(double p) const { return keyed ? keyed->P(p) : pool ? pool->P(p) : Source().P(p); }
+  double GetNormal(double mean = 0.0, double std = 1.0) const { return keyed ? keyed->GetNormal(mean, std) : pool ? pool->GetNormal(mean, std) : Source().GetNormal(mean, std); }
+  uint32_t GetPoisson(double mean) const { return keyed ? keyed->GetPoisson(mean) : pool ? pool->GetPoisson(mean) : Source().GetPoisson(mean); }
+
+  /**
+   * Input: None
+   *
+   * Output: The organism's own generator, ignoring any tile generator.
+   *
+   * Purpose: To hand the organism's generator on to its offspring.
+   */
+  operator emp::Ptr<emp::Random>() const { return random; }
+};
+
 class SymWorld : public emp::World<Organism>{
 public:
   using taxon_info_t = double;
@@ -78,6 +212,14 @@ protected:
   */
   emp::Ptr<emp::Systematics<Organism, taxon_info_t, datastruct::TaxonDataBase>> sym_sys;
 
+  /**
+    *
+    * Purpose: Represents the file the interaction counts of host taxa are
+    * streamed to as the taxa go extinct, when STREAM_PHYLOGENY is on.
+    *
+  */
+  PhylogenyStream interaction_stream;
+
   /**
     *
     * Purpose: Represents the tag distance calculator.
@@ -85,6 +227,14 @@ protected:
   */
   emp::Ptr<emp::HammingMetric<TAG_LENGTH>> hamming_metric;
 
+  /**
+    *
+    * Purpose: Represents the distribution tag matching cutoffs are drawn
+    * from, a Poisson with mean TAG_DISTANCE * TAG_LENGTH.
+    *
+  */
+  PoissonTable tag_cutoffs;
+
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_hostintval; // New() reallocates this pointer
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_symintval;
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_freesymintval;
@@ -117,10 +267,229 @@ protected:
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_attempts_verttrans;
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_successes_verttrans;
 
+  /**
+    *
+    * Purpose: Represents the population laid out in columns for data node scans.
+    * It is created by the first data node that needs it and refilled at the
+    * start of every update, before any of those data nodes run.
+    *
+  */
+  emp::Ptr<PopulationStore> population_store = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the scans that fill the population data nodes, whether
+    * each scan is out of date, and which scan fills each data node.
+    *
+  */
+  emp::vector<std::function<void()>> data_node_scans;
+  emp::vector<bool> data_node_scan_stale;
+  std::unordered_map<const void *, size_t> data_node_scan_ids;
+
+  /**
+    *
+    * Purpose: Represents whether data node scans only run on the updates that
+    * data files sample (every DATA_INT updates). CreateDataFiles() turns this
+    * on; otherwise every scan runs every update.
+    *
+  */
+  bool lazy_data_nodes = false;
+
+  /**
+    *
+    * Purpose: Represents population counts that are kept up to date as
+    * organisms are placed, die, infect hosts and leave them, so they can be
+    * read without scanning the world. The host count is num_orgs minus
+    * num_free_syms.
+    *
+  */
+  size_t num_free_syms = 0;
+  size_t num_hosted_syms = 0;
+  size_t num_uninfected_hosts = 0;
+
+  /**
+    *
+    * Purpose: Represents the cells holding a host or a free-living symbiont,
+    * kept up to date alongside the population counts, so that sparse worlds
+    * can be scheduled and censused without visiting their empty cells.
+    *
+  */
+  OccupancyIndex occupancy;
+
+  /**
+    *
+    * Purpose: Represents the neighbors of every cell when the world is a
+    * grid, rebuilt whenever the grid's dimensions change.
+    *
+  */
+  NeighborTable neighbor_table;
+
+  /**
+    *
+    * Purpose: Represents how often each tag occurs among the hosts and among
+    * their symbionts, kept up to date as hosts are placed and die, symbionts
+    * join and leave hosts, and placed symbionts mutate. Only tracked once the
+    * tag diversity data nodes are set up.
+    *
+  */
+  bool track_tag_frequencies = false;
+  TagFrequencyTable host_tag_frequencies;
+  TagFrequencyTable sym_tag_frequencies;
+
+  /**
+    *
+    * Purpose: Represents how many of RunExperiment()'s updates have finished,
+    * so that a run resumed from a checkpoint picks up where it left off.
+    *
+  */
+  size_t experiment_updates = 0;
+
+  /**
+    *
+    * Purpose: Represents whether the world was just restored from a
+    * checkpoint written partway through Update(), after the data files were
+    * written, as periodic checkpoints are. The next Update() then skips the
+    * part that already ran.
+    *
+  */
+  bool resuming_update = false;
+
+  /**
+    *
+    * Purpose: Represents the data files a restored checkpoint had written, and
+    * how many bytes of each it had written. SetupFile() continues these files
+    * from that point rather than starting them over.
+    *
+  */
+  std::unordered_map<std::string, uint64_t> resume_file_sizes;
+
   // the taxon IDs of the first mutualistic pair (where BOTH sym and host are mutualistic)
   uint64_t first_mut_sym = 0;
   uint64_t first_mut_host = 0;
 
+  /**
+    *
+    * Purpose: Represents the threads that process grid tiles (and write the tag matrix)
+    * when UPDATE_THREADS is above 1.
+    *
+  */
+  emp::Ptr<WorkerPool> update_pool = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the cells belonging to each tile, in the order they were last processed.
+    *
+  */
+  emp::vector<emp::vector<size_t>> tile_cells;
+
+  /**
+    *
+    * Purpose: Represents the four checkerboard phases of a tiled update. Tiles
+    * within a phase are never adjacent, so they can be processed at the same time.
+    *
+  */
+  emp::vector<emp::vector<size_t>> tile_phases;
+
+  /**
+    *
+    * Purpose: Represents the random number generator of each tile. They are
+    * reseeded from the world's generator every update, so which thread
+    * processes a tile doesn't change its draws.
+    *
+  */
+  emp::vector<emp::Random> tile_randoms;
+
+  /**
+    *
+    * Purpose: Represents the share of the world's limited resources each tile
+    * can pull from during a parallel tile update. Tiles never draw on a
+    * common total, so what they get doesn't depend on thread timing.
+    *
+  */
+  emp::vector<int> tile_res;
+
+  /**
+    *
+    * Purpose: Represents the budget of the tile this thread is processing, or
+    * nullptr if organisms pull from total_res.
+    *
+  */
+  static inline thread_local emp::Ptr<int> tile_res_budget = nullptr;
+
+  /**
+    *
+    * Purpose: Represents the random number pools organisms draw from when
+    * RANDOM_POOL is on: one for a serial update and one for each tile. They
+    * are reseeded from the world's or tile's generator every update.
+    *
+  */
+  RandomPool world_random_pool;
+  emp::vector<RandomPool> tile_random_pools;
+
+  /**
+    *
+    * Purpose: Represents the keyed generators cells are processed with when
+    * KEYED_RANDOM is on: one for a serial update and one for each tile.
+    *
+  */
+  KeyedRandom world_keyed_random;
+  emp::vector<KeyedRandom> tile_keyed_randoms;
+
+  /**
+    *
+    * Purpose: Represents the grid width, grid height and tile size that the current tiles were built for.
+    *
+  */
+  std::array<size_t, 3> tile_layout = {0, 0, 0};
+
+  /**
+    *
+    * Purpose: Represents the scheduler that orders the cells of a serial
+    * update, and the SCHEDULER and SCHEDULE_BLOCK_SIZE settings it was made for.
+    *
+  */
+  emp::Ptr<UpdateScheduler> scheduler = nullptr;
+  std::array<int, 2> scheduler_settings = {-1, -1};
+
+  /**
+    *
+    * Purpose: Guards world state that neighboring tiles share (the organism
+    * count, graveyard, limited resources and organism-recorded data nodes)
+    * during a parallel tile update.
+    *
+  */
+  std::mutex shared_state_mutex;
+
+  /**
+    *
+    * Purpose: Represents the time spent in each phase of Update() and the
+    * events counted since the profile file last wrote them out. It is only
+    * filled in when compiled with -DSYM_PROFILE.
+    *
+  */
+  UpdateProfiler profiler;
+
+  using process_cell_fun_t = void (SymWorld::*)(size_t);
+
+  /**
+    *
+    * Purpose: Represents the pre-instantiated cell kernels, indexed by
+    * ECTOSYMBIOSIS + 2 * FREE_LIVING_SYMS. They are all the fully virtual
+    * ProcessCell() unless a binary fixes its host and symbiont types with
+    * UseModePolicy().
+    *
+  */
+  std::array<process_cell_fun_t, 4> process_cell_kernels = {
+    &SymWorld::ProcessCell, &SymWorld::ProcessCell, &SymWorld::ProcessCell, &SymWorld::ProcessCell};
+
+  /**
+    *
+    * Purpose: Represents the kernel Update() uses to process each cell,
+    * chosen from process_cell_kernels by ResolveProcessKernel().
+    *
+  */
+  process_cell_fun_t process_cell_fun = &SymWorld::ProcessCell;
+
 public:
   /**
    * Input: The world's random seed and a pointer to this world's config object
@@ -139,6 +508,16 @@ public:
 
     emp_assert(!(my_config->TAG_MATCHING() && my_config->FREE_LIVING_SYMS()));
 
+    // only hosts go through emp::World placement; free-living syms are counted in AddOrgAt
+    OnPlacement([this](emp::WorldPosition pos) {
+      CountHost(pop[pos.GetIndex()], true);
+      occupancy.Set(pos.GetIndex(), OccupancyIndex::HOST, true);
+    });
+    OnOrgDeath([this](size_t pos) {
+      CountHost(pop[pos], false);
+      occupancy.Set(pos, OccupancyIndex::HOST, false);
+    });
+
     if (my_config->PHYLOGENY() == true) {
       if (my_config->PHYLOGENY_TAXON_TYPE() == 1) {
         calc_host_info_fun = [&](Organism& org) {
@@ -163,6 +542,8 @@ public:
         GetOrgPtr(pos.GetIndex())->SetTaxon(host_sys->GetTaxonAt(pos).Cast<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>>());
         });
 
+      if (my_config->STREAM_PHYLOGENY()) SetUpPhylogenyStreams();
+
     }
 
     if (my_config->TAG_MATCHING()) {
@@ -179,6 +560,7 @@ public:
    * Purpose: To destruct the objects belonging to SymWorld to conserve memory.
    */
   virtual ~SymWorld() {
+    if (scheduler) scheduler.Delete();
     if (data_node_hostintval) data_node_hostintval.Delete();
     if (data_node_symintval) data_node_symintval.Delete();
     if (data_node_freesymintval) data_node_freesymintval.Delete();
@@ -210,16 +592,22 @@ public:
     if (data_node_successes_horiztrans) data_node_successes_horiztrans.Delete();
     if (data_node_attempts_verttrans) data_node_attempts_verttrans.Delete();
     if (data_node_successes_verttrans) data_node_successes_verttrans.Delete();
+    if (update_pool) update_pool.Delete();
+    if (population_store) population_store.Delete();
 
-    for(size_t i = 0; i < sym_pop.size(); i++){ //host population deletion is handled by empirical world destructor
+    for(size_t i = 0; i < sym_pop.size(); i++){
       if(sym_pop[i]) {
         DoSymDeath(i);
       }
     }
 
+    // delete hosts here rather than in the empirical world destructor, while
+    // the population counts their removal updates still exist, and so that
+    // hosted symbionts get deleted and unlinked from the sym_sys
+    interaction_stream.Close();
+    Clear();
+
     if(my_config->PHYLOGENY()){ //host systematic deletion is handled by empirical world destructor
-      Clear(); // delete hosts here so that hosted symbionts get 
-      // deleted and unlinked from the sym_sys
       sym_sys.Delete();
     }
 
@@ -271,6 +659,33 @@ public:
     return hamming_metric;
   }
 
+  /**
+   * Input: None
+   *
+   * Output: The distribution of tag matching cutoffs.
+   *
+   * Purpose: To get the distribution tag matching cutoffs are drawn from,
+   * tabulating it again if TAG_DISTANCE has changed.
+   */
+  const PoissonTable & GetTagCutoffs() {
+    const double mean = my_config->TAG_DISTANCE() * TAG_LENGTH;
+    if (mean != tag_cutoffs.GetMean()) tag_cutoffs.Build(mean);
+    return tag_cutoffs;
+  }
+
+  /**
+   * Input: The generator to draw with.
+   *
+   * Output: The most bits a symbiont's tag can differ from a host's by and
+   * still infect it.
+   *
+   * Purpose: To draw a tag matching cutoff.
+   */
+  template <typename RANDOM_T>
+  uint32_t DrawTagCutoff(RANDOM_T & random) {
+    return GetTagCutoffs().Sample(random.GetDouble());
+  }
+
   /**
    * Input: None
    *
@@ -281,6 +696,53 @@ public:
   emp::vector<emp::Ptr<Organism>>& GetGraveyard() { return graveyard; }
 
 
+  /**
+   * Input: None
+   *
+   * Output: A reference to the random number generator draws should come from.
+   *
+   * Purpose: To get the world's random number generator, or the generator of
+   * the tile being processed when called from a parallel tile update, or of
+   * the cell being processed when KEYED_RANDOM is on.
+   */
+  emp::Random & GetRandom() {
+    if (OrgRandomPtr::keyed) return OrgRandomPtr::keyed->GetCellRandom();
+    if (OrgRandomPtr::tile_random) return *OrgRandomPtr::tile_random;
+    return emp::World<Organism>::GetRandom();
+  }
+
+
+  /**
+   * Input: None
+   *
+   * Output: A lock on the state shared between tiles, which holds nothing
+   * outside of a parallel tile update.
+   *
+   * Purpose: To serialize changes to shared world state while tiles are
+   * processed in parallel, without locking during serial updates.
+   */
+  std::unique_lock<std::mutex> LockSharedState() {
+    if (OrgRandomPtr::tile_random) return std::unique_lock<std::mutex>(shared_state_mutex);
+    return std::unique_lock<std::mutex>();
+  }
+
+
+  /**
+   * Input: The data node to record into, and the value to record.
+   *
+   * Output: None
+   *
+   * Purpose: To record a datum while organisms are being processed. Should be
+   * used by organisms instead of calling AddDatum directly, so that tiles
+   * processed in parallel do not update a node at the same time.
+   */
+  template <typename NODE_T, typename VAL_T>
+  void RecordDatum(NODE_T & node, VAL_T value) {
+    auto lock = LockSharedState();
+    node.AddDatum(value);
+  }
+
+
   /**
    * Input: None
    *
@@ -385,21 +847,36 @@ public:
    * then total_res will be returned. If none of these are true, then 0 will be returned.
    *
    * Purpose: To determine how many resources to distribute to each organism.
+   * During a parallel tile update, organisms pull from their tile's budget
+   * instead of total_res.
    */
   int PullResources(int desired_resources) {
     if(total_res == -1) { //if LIMITED_RES_TOTAL == -1, unlimited
       return desired_resources;
+    } else if (tile_res_budget) {
+      return TakeResources(*tile_res_budget, desired_resources);
     } else {
-      if (total_res>=desired_resources) {
-        total_res = total_res - desired_resources;
-        return desired_resources;
-      } else if (total_res>0) {
-        int resources_to_return = total_res;
-        total_res = 0;
-        return resources_to_return;
-      } else {
-        return 0;
-      }
+      return TakeResources(total_res, desired_resources);
+    }
+  }
+
+  /**
+   * Input: The resources available, and the amount an organism wants.
+   *
+   * Output: The amount the organism gets, which is taken out of those available.
+   *
+   * Purpose: To hand out resources from a limited supply.
+   */
+  static int TakeResources(int & available, int desired_resources) {
+    if (available>=desired_resources) {
+      available = available - desired_resources;
+      return desired_resources;
+    } else if (available>0) {
+      int resources_to_return = available;
+      available = 0;
+      return resources_to_return;
+    } else {
+      return 0;
     }
   }
 
@@ -419,6 +896,42 @@ public:
   }
 
 
+  /**
+   * Input: The name of the data file to create.
+   *
+   * Output: The ColumnarDataFile that has been created.
+   *
+   * Purpose: To overwrite the empirical SetupFile so that data files are
+   * written in the binary columnar format when BINARY_DATA_FILES is on. Binary
+   * files swap a .data extension for .cdata.
+   */
+  ColumnarDataFile & SetupFile(const std::string & filename) {
+    bool binary = my_config->BINARY_DATA_FILES();
+    std::string path = filename;
+    if (binary) {
+      const std::string csv_ending = ".data";
+      if (path.size() >= csv_ending.size() && path.compare(path.size() - csv_ending.size(), csv_ending.size(), csv_ending) == 0) {
+        path.resize(path.size() - csv_ending.size());
+      }
+      path += ".cdata";
+    }
+    // a file continued from a checkpoint keeps what was written up to the
+    // checkpoint, and drops anything written after it
+    auto resume = resume_file_sizes.find(path);
+    std::string written;
+    if (resume != resume_file_sizes.end()) {
+      std::ifstream earlier(path, std::ios::binary);
+      written.resize(resume->second);
+      earlier.read(written.data(), written.size());
+      if (!earlier) throw "Data file is shorter than when the checkpoint was written";
+    }
+    emp::Ptr<ColumnarDataFile> file = emp::NewPtr<ColumnarDataFile>(path, binary);
+    if (resume != resume_file_sizes.end()) file->Resume(written);
+    files.push_back(file);
+    return *file;
+  }
+
+
   /**
    * Input: The size_t representing the new size of the world
    *
@@ -432,6 +945,7 @@ public:
     pop.resize(new_size);
     sym_pop.resize(new_size);
     pop_sizes.resize(2);
+    occupancy.Resize(new_size);
   }
 
   /**
@@ -442,6 +956,8 @@ public:
    * Purpose: To add organisms to the graveyard
    */
   void SendToGraveyard(emp::Ptr<Organism> org) {
+    auto lock = LockSharedState();
+    SYM_PROFILE_COUNT(DEATHS);
     graveyard.push_back(org);
   }
 
@@ -458,6 +974,7 @@ public:
   void AddOrgAt(emp::Ptr<Organism> new_org, emp::WorldPosition pos, emp::WorldPosition p_pos=emp::WorldPosition()) {
     emp_assert(new_org);         // The new organism must exist.
     emp_assert(pos.IsValid());   // Position must be legal.
+    auto lock = LockSharedState();
 
     //SYMBIONTS have position in the overall world as their ID
     //HOSTS have position in the overall world as their index
@@ -476,12 +993,14 @@ public:
       size_t pos_id = pos.GetPopID();
       if(!sym_pop[pos_id]) {
         ++num_orgs;
+        ++num_free_syms;
       } else {
         sym_pop[pos_id].Delete();
       }
 
       //set the cell to point to the new sym
       sym_pop[pos_id] = new_org;
+      occupancy.Set(pos_id, OccupancyIndex::FREE_SYM, true);
     }
   }
 
@@ -502,10 +1021,14 @@ public:
     emp::WorldPosition pos; // Position of each offspring placed.
 
     offspring_ready_sig.Trigger(*new_org, parent_pos);
-    pos = fun_find_birth_pos(new_org, parent_pos);
+    // on grids (where tiled updates run) the birth position is a random neighbor;
+    // GetRandomNeighborPos looks it up and draws it from the tile's (or keyed cell's) generator
+    if (IsSpaceStructured() || OrgRandomPtr::tile_random || OrgRandomPtr::keyed) pos = GetRandomNeighborPos(parent_pos);
+    else pos = fun_find_birth_pos(new_org, parent_pos);
     if (pos.IsValid() && (pos.GetIndex() != parent_pos)) {
       //Add to the specified position, overwriting what may exist there
       AddOrgAt(new_org, pos, parent_pos);
+      SYM_PROFILE_COUNT(BIRTHS);
       if (my_config->PHYLOGENY() && my_config->TRACK_PHYLOGENY_INTERACTIONS()) {
         datastruct::TaxonDataBase & my_data = new_org->GetTaxon()->GetData();
         datastruct::HostTaxonData * d = static_cast<datastruct::HostTaxonData*>(&my_data);
@@ -527,6 +1050,55 @@ public:
   }
 
 
+  /**
+   * Input: None
+   *
+   * Output: The neighbors of every cell of the grid.
+   *
+   * Purpose: To get the grid's neighbor table, building it again if the
+   * grid's dimensions have changed.
+   */
+  const NeighborTable & GetNeighborTable() {
+    if (!neighbor_table.Fits(GetWidth(), GetHeight())) neighbor_table.Build(GetWidth(), GetHeight());
+    return neighbor_table;
+  }
+
+  /**
+   * Input: The position whose neighbor should be chosen.
+   *
+   * Output: The position of a random cell among the 3x3 cells centered on
+   * the given position.
+   *
+   * Purpose: To overwrite the Empirical GetRandomNeighborPos so that grid
+   * neighbors come from the neighbor table, and parallel tile updates and keyed
+   * cells draw from their own generator rather than the world's. Outside of a
+   * grid every cell is a neighbor.
+   */
+  emp::WorldPosition GetRandomNeighborPos(emp::WorldPosition pos) {
+    if (!IsSpaceStructured()) {
+      if (!OrgRandomPtr::tile_random && !OrgRandomPtr::keyed) return emp::World<Organism>::GetRandomNeighborPos(pos);
+      return emp::WorldPosition(GetRandom().GetUInt(GetSize()), pos.GetPopID());
+    }
+    const size_t offset = GetRandom().GetUInt(NeighborTable::MOORE_SIZE);
+    return emp::WorldPosition(GetNeighborTable().GetMooreNeighbor(pos.GetIndex(), offset), pos.GetPopID());
+  }
+
+
+  /**
+   * Input: The position of the host to be removed.
+   *
+   * Output: None
+   *
+   * Purpose: To overwrite the Empirical DoDeath so that removing a host is
+   * serialized during parallel tile updates.
+   */
+  void DoDeath(emp::WorldPosition pos) {
+    auto lock = LockSharedState();
+    SYM_PROFILE_COUNT(DEATHS);
+    emp::World<Organism>::DoDeath(pos);
+  }
+
+
   /**
    * Input: The size_t value representing the location whose neighbors
    * are being searched.
@@ -545,13 +1117,24 @@ public:
         return neighbor.GetIndex();
     }
 
-    // Then enumerate all occupied neighbors, in case many neighbors are unoccupied
-    const emp::vector<size_t> validNeighbors = GetValidNeighborOrgIDs(id);
-    if (validNeighbors.empty()) return -1;
-    else {
-      int randI = GetRandom().GetUInt(0, validNeighbors.size());
-      return validNeighbors[randI];
+    // Then pick among all occupied neighbors, in case many neighbors are
+    // unoccupied, in the order Empirical's GetValidNeighborOrgIDs lists them
+    if (IsSpaceStructured()) {
+      const NeighborTable & table = GetNeighborTable();
+      const uint32_t occupied = table.GetOccupiedMask(id, [this](size_t cell) { return (bool) pop[cell]; });
+      if (!occupied) return -1;
+      const size_t pick = GetRandom().GetUInt(0, std::popcount(occupied));
+      return table.GetMooreNeighbor(id, NeighborTable::NthOffset(occupied, pick));
+    }
+    // outside of a grid every other host is a neighbor; count to the pick
+    // rather than listing them
+    const size_t num_neighbors = GetNumHosts() - (IsOccupied(id) ? 1 : 0);
+    if (num_neighbors == 0) return -1;
+    size_t pick = GetRandom().GetUInt(0, num_neighbors);
+    for (size_t i = 0; i < pop.size(); i++) {
+      if (pop[i] && i != id && pick-- == 0) return i;
     }
+    return -1;
   }
 
 
@@ -587,11 +1170,12 @@ public:
       new_loc = GetRandomOrgID();
       //if the position is acceptable, add the sym to the host in that position
       if(IsOccupied(new_loc)) {
+        // the tag is set first so the host counts the symbiont's final tag
+        if(my_config->TAG_MATCHING()){
+          new_sym->SetTag(pop[new_loc]->GetTag());
+        }
         int sucess = pop[new_loc]->AddSymbiont(new_sym);
         if(sucess) {
-          if(my_config->TAG_MATCHING()){
-            new_sym->SetTag(pop[new_loc]->GetTag());
-          }
           if (my_config->PHYLOGENY() && my_config->TRACK_PHYLOGENY_INTERACTIONS()) {
             datastruct::HostTaxonData* d = static_cast<datastruct::HostTaxonData*>(&pop[new_loc]->GetTaxon()->GetData());
             d->AddInteraction(new_sym->GetTaxon());
@@ -613,7 +1197,69 @@ public:
    * Definitions of data node functions, expanded in DataNodes.h
    */
   virtual void CreateDataFiles();
+  virtual void CreateProcessDataNodes();
+  PopulationStore & GetPopulationStore();
+  void SyncPopulationStore();
+  size_t AddHostCensusColumn(PopulationStore::extractor_t extractor);
+  size_t AddSymCensusColumn(PopulationStore::extractor_t extractor, bool free_living = true);
+  void AddDataNodeScan(std::initializer_list<const void *> nodes, std::function<void()> scan);
+  void RefreshDataNode(const void * node);
+  bool IsDataUpdate(size_t ud);
+  void SetLazyDataNodes(bool _in) {lazy_data_nodes = _in;}
+  void CountHost(emp::Ptr<Organism> host, bool placed);
+  void CountHostedSymChange(size_t old_count, size_t new_count);
+  void CountHostTags(emp::Ptr<Organism> host, bool placed);
+  void CountSymTag(const emp::BitSet<TAG_LENGTH> & tag, bool added);
+  void TrackTagFrequencies();
+  bool CheckPopulationCounts();
+
+  /**
+   * Input: None
+   *
+   * Output: The number of hosts in the world.
+   *
+   * Purpose: To count hosts without scanning the world.
+   */
+  size_t GetNumHosts() const { return num_orgs - num_free_syms; }
+
+  /**
+   * Input: None
+   *
+   * Output: The index of the cells holding a host or a free-living symbiont.
+   *
+   * Purpose: To walk only the live cells of the world.
+   */
+  OccupancyIndex & GetOccupancy() { return occupancy; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of free-living symbionts in the world.
+   *
+   * Purpose: To count free-living symbionts without scanning the world.
+   */
+  size_t GetNumFreeSyms() const { return num_free_syms; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of symbionts living in the world's hosts.
+   *
+   * Purpose: To count hosted symbionts without scanning the world.
+   */
+  size_t GetNumHostedSyms() const { return num_hosted_syms; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of hosts in the world without symbionts.
+   *
+   * Purpose: To count uninfected hosts without scanning the world.
+   */
+  size_t GetNumUninfectedHosts() const { return num_uninfected_hosts; }
   void MapPhylogenyInteractions();
+  size_t GetInteractionMemoryBytes();
+  void SetUpPhylogenyStreams();
   void WritePhylogenyFile(const std::string & filename);
   void WriteOrgDumpFile(const std::string& filename);
   void WriteTagMatrixFile(const std::string& filename);
@@ -628,7 +1274,8 @@ public:
   emp::DataFile & SetUpTransmissionFile(const std::string & filename);
   emp::DataFile & SetUpTagDistFile(const std::string& filename);
   emp::DataFile & SetupSymDiversityFile(const std::string & filename);
-  virtual void SetupHostFileColumns(emp::DataFile & file);
+  emp::DataFile & SetUpProfileFile(const std::string & filename);
+  virtual void SetupHostFileColumns(ColumnarDataFile & file);
   emp::DataMonitor<int>& GetHostCountDataNode();
   emp::DataMonitor<int>& GetSymCountDataNode();
   emp::DataMonitor<int>& GetCountHostedSymsDataNode();
@@ -668,6 +1315,7 @@ public:
   virtual void Setup();
   virtual void SetupHosts(long unsigned int* POP_SIZE);
   virtual void SetupSymbionts(long unsigned int* total_syms);
+  virtual emp::Ptr<Organism> NewCheckpointOrg(const std::string & name);
 
   /**
    * Input: The pointer to the symbiont that is moving, the WorldPosition of its
@@ -726,6 +1374,7 @@ public:
    * no eligible near-by hosts.
    */
    emp::WorldPosition SymDoBirth(emp::Ptr<Organism> sym_baby, emp::WorldPosition parent_pos) {
+    SYM_PROFILE_COUNT(HORIZ_TRANS_ATTEMPTS);
     size_t i = parent_pos.GetPopID();
     if(my_config->FREE_LIVING_SYMS() == 0){
       int new_host_pos = GetNeighborHost(i);
@@ -743,16 +1392,16 @@ public:
         bool size_failed = pop[new_host_pos]->GetSymbionts().size() >= (long unsigned)my_config->SYM_LIMIT();
         bool tag_failed = false;
         if (my_config->TAG_MATCHING()){
-          double tag_distance = hamming_metric->calculate(pop[new_host_pos]->GetTag(), sym_baby->GetTag()) * TAG_LENGTH;
-          double cutoff = GetRandom().GetPoisson(my_config->TAG_DISTANCE() * TAG_LENGTH);
+          double tag_distance = PackedTags<TAG_LENGTH>::Distance(pop[new_host_pos]->GetTag(), sym_baby->GetTag());
+          double cutoff = DrawTagCutoff(GetRandom());
           tag_failed = tag_distance > cutoff;
         }
         if (size_failed || tag_failed) {
           if (tag_failed && !size_failed) {
-            GetHorizontalTransmissionTagFailCount().AddDatum(sym_parent->GetIntVal());
+            RecordDatum(GetHorizontalTransmissionTagFailCount(), sym_parent->GetIntVal());
           }
           else if (!tag_failed && size_failed) {
-            GetHorizontalTransmissionSizeFailCount().AddDatum(sym_parent->GetIntVal());
+            RecordDatum(GetHorizontalTransmissionSizeFailCount(), sym_parent->GetIntVal());
           }
           sym_baby.Delete();
           return emp::WorldPosition();
@@ -768,6 +1417,7 @@ public:
             // if tag mismatch or free failure is on, don't subtract points until we think the infection is successful
             sym_parent->SetPoints(0);
           }
+          SYM_PROFILE_COUNT(BIRTHS);
           return emp::WorldPosition(new_index, new_host_pos);
         } else { //sym got killed trying to infect
           return emp::WorldPosition();
@@ -777,7 +1427,9 @@ public:
         return emp::WorldPosition();
       }
     } else {
-      return MoveIntoNewFreeWorldPos(sym_baby, parent_pos);
+      emp::WorldPosition new_pos = MoveIntoNewFreeWorldPos(sym_baby, parent_pos);
+      if (new_pos.IsValid()) SYM_PROFILE_COUNT(BIRTHS);
+      return new_pos;
     }
   }
 
@@ -794,10 +1446,12 @@ public:
     //the sym can either move into a parallel sym or to some random position
     if(IsOccupied(i) && sym_pop[i]->WantsToInfect()) {
       emp::Ptr<Organism> sym = ExtractSym(i);
+      SYM_PROFILE_COUNT(MOVEMENTS);
       if(sym->InfectionFails()) sym.Delete(); //if the sym tries to infect and fails it dies
       else pop[i]->AddSymbiont(sym);
     }
     else if(my_config->MOVE_FREE_SYMS()) {
+      SYM_PROFILE_COUNT(MOVEMENTS);
       MoveIntoNewFreeWorldPos(ExtractSym(i), pos);
     }
   }
@@ -827,10 +1481,13 @@ public:
    */
   emp::Ptr<Organism> ExtractSym(size_t i){
     emp::Ptr<Organism> sym;
+    auto lock = LockSharedState();
     if(sym_pop[i]){
       sym = sym_pop[i];
       num_orgs--;
+      num_free_syms--;
       sym_pop[i] = nullptr;
+      occupancy.Set(i, OccupancyIndex::FREE_SYM, false);
     }
     return sym;
   }
@@ -844,10 +1501,14 @@ public:
    * Purpose: To delete a symbiont from the world.
    */
   void DoSymDeath(size_t i){
+    auto lock = LockSharedState();
     if(sym_pop[i]){
+      SYM_PROFILE_COUNT(DEATHS);
       sym_pop[i].Delete();
       sym_pop[i] = nullptr;
       num_orgs--;
+      num_free_syms--;
+      occupancy.Set(i, OccupancyIndex::FREE_SYM, false);
     }
   }
 
@@ -873,21 +1534,187 @@ public:
   }
 
   /**
-   * Input: Optional boolean "verbose" that specifies whether to print the update numbers to standard output or not, defaults to true.
+   * Input: None
+   *
+   * Output: The name of the checkpoint file for this run's settings.
+   *
+   * Purpose: To name the file periodic checkpoints are written to and
+   * resumed from.
+   */
+  std::string GetCheckpointFileName() {
+    return my_config->FILE_PATH() + "Checkpoint" + my_config->FILE_NAME() + "_SEED" + std::to_string(my_config->SEED()) + ".chk";
+  }
+
+  /**
+   * Input: The name of the checkpoint file to write, and whether it is being
+   * written partway through Update(), just after the data files.
+   *
+   * Output: None
+   *
+   * Purpose: To save the complete state of the world: every host with its
+   * symbionts, every free-living symbiont, the random number generator, the
+   * update count, the limited resource total, the cell order of each tile,
+   * and how far each data file has been written. It is written to a temporary file first, so an
+   * interrupted write never replaces the previous checkpoint.
+   *
+   * Periodic checkpoints are written on data updates, just after the data
+   * files are written. The data nodes organisms record into are reset by
+   * their files at that point, and the others are rebuilt from the
+   * population, so no data node state needs to be saved.
+   */
+  void WriteCheckpoint(const std::string & filename, bool mid_update = false) {
+    if (my_config->PHYLOGENY()) throw "Checkpoints can't be written while PHYLOGENY is on";
+    const std::string temp_filename = filename + ".tmp";
+    CheckpointWriter out(temp_filename);
+    out.WriteString("SYMCHK01");
+    out.Write(mid_update);
+    out.Write((uint64_t) update);
+    out.Write((uint64_t) experiment_updates);
+    out.Write(total_res);
+
+    out.Write((uint64_t) pop.size());
+    out.Write((uint64_t) sym_pop.size());
+    for (pop_t * cells : {&pop, &sym_pop}) {
+      for (emp::Ptr<Organism> org : *cells) {
+        out.Write((bool) org);
+        if (!org) continue;
+        out.WriteString(org->GetName());
+        org->WriteState(out);
+      }
+    }
+    out.Write(emp::World<Organism>::GetRandom());
+
+    // each tile shuffles its cells starting from the order it left them in
+    out.Write((uint64_t) tile_cells.size());
+    for (const emp::vector<size_t> & cells : tile_cells) {
+      out.Write((uint64_t) cells.size());
+      for (size_t cell : cells) out.Write((uint64_t) cell);
+    }
+
+    out.Write((uint64_t) files.size());
+    for (emp::Ptr<emp::DataFile> file : files) {
+      emp::Ptr<ColumnarDataFile> columnar_file = file.DynamicCast<ColumnarDataFile>();
+      if (!columnar_file) throw "Checkpoints only support data files created with SymWorld::SetupFile()";
+      out.WriteString(columnar_file->GetFilename());
+      out.Write(columnar_file->Checkpoint());
+    }
+    out.Close();
+    if (std::rename(temp_filename.c_str(), filename.c_str()) != 0) throw "Could not replace the checkpoint file";
+  }
+
+  /**
+   * Input: The name of the checkpoint file to read.
+   *
+   * Output: None
+   *
+   * Purpose: To replace the world's population and state with those saved by
+   * WriteCheckpoint(). The world must be constructed with the same settings
+   * and Setup() before loading, and data files should be created after
+   * loading, so they continue from where the checkpoint left them. The
+   * resumed run then matches the run that wrote the checkpoint exactly.
+   */
+  void LoadCheckpoint(const std::string & filename) {
+    CheckpointReader in(filename);
+    if (in.ReadString() != "SYMCHK01") throw "Not a Symbulation checkpoint file";
+    bool mid_update = in.Read<bool>();
+
+    for (size_t i = 0; i < pop.size(); i++) {
+      if (pop[i]) DoDeath(i);
+      if (i < sym_pop.size() && sym_pop[i]) DoSymDeath(i);
+    }
+
+    update = in.Read<uint64_t>();
+    experiment_updates = in.Read<uint64_t>();
+    in.Read(total_res);
+
+    size_t pop_size = in.Read<uint64_t>();
+    size_t sym_pop_size = in.Read<uint64_t>();
+    if (pop_size != sym_pop_size) throw "Checkpoint population sizes don't match";
+    if (pop_size != pop.size()) throw "Checkpoint was written for a different world size";
+    for (size_t i = 0; i < pop_size; i++) {
+      if (!in.Read<bool>()) continue;
+      emp::Ptr<Organism> host = NewCheckpointOrg(in.ReadString());
+      host->ReadState(in);
+      AddOrgAt(host, i);
+    }
+    for (size_t i = 0; i < sym_pop_size; i++) {
+      if (!in.Read<bool>()) continue;
+      emp::Ptr<Organism> sym = NewCheckpointOrg(in.ReadString());
+      sym->ReadState(in);
+      AddOrgAt(sym, emp::WorldPosition(0, i));
+    }
+    // organisms draw from the generator as they are constructed, so it is
+    // restored last
+    in.Read(emp::World<Organism>::GetRandom());
+
+    size_t num_tiles = in.Read<uint64_t>();
+    if (num_tiles > 0) {
+      if (!UseTiledUpdate() || num_tiles != tile_cells.size()) throw "Checkpoint was written with different tiles";
+      for (emp::vector<size_t> & cells : tile_cells) {
+        if (in.Read<uint64_t>() != cells.size()) throw "Checkpoint was written with different tiles";
+        for (size_t & cell : cells) cell = in.Read<uint64_t>();
+      }
+    }
+
+    resume_file_sizes.clear();
+    size_t num_files = in.Read<uint64_t>();
+    for (size_t i = 0; i < num_files; i++) {
+      std::string file_name = in.ReadString();
+      resume_file_sizes[file_name] = in.Read<uint64_t>();
+    }
+
+    for (size_t i = 0; i < data_node_scan_stale.size(); i++) data_node_scan_stale[i] = true;
+    resuming_update = mid_update;
+  }
+
+  /**
+   * Input: The number of updates run so far, the seconds they took, and the
+   * number of updates left to run.
+   *
+   * Output: The throughput and estimated time left, to add to a progress
+   * line, or nothing if no updates have run yet.
+   *
+   * Purpose: To report how fast an experiment is going.
+   */
+  static std::string FormatProgress(size_t updates_done, double seconds, size_t updates_left) {
+    if (updates_done == 0 || seconds <= 0) return "";
+    double updates_per_second = updates_done / seconds;
+    size_t seconds_left = (size_t) (updates_left / updates_per_second + 0.5);
+    std::stringstream progress;
+    progress << std::fixed << std::setprecision(1) << " (" << updates_per_second << " updates/s, ETA ";
+    if (seconds_left >= 3600) progress << seconds_left / 3600 << "h ";
+    if (seconds_left >= 60) progress << seconds_left / 60 % 60 << "m ";
+    progress << seconds_left % 60 << "s)";
+    return progress.str();
+  }
+
+  /**
+   * Input: Optional boolean "verbose" that specifies whether to print the update numbers or not, defaults to true,
+   * and the stream to print them to, which defaults to standard output.
    *
    * Output: None
    *
    * Purpose: Run the number of updates and non-mutation updates specified in the configuration settings.
+   * A world restored from a checkpoint runs only the updates that remain. Progress lines
+   * include the updates per second so far and the estimated time left.
    */
-  void RunExperiment(bool verbose=true) {
+  void RunExperiment(bool verbose=true, std::ostream & log=std::cout) {
     //Loop through updates
     int numupdates = my_config->UPDATES();
-    for (int i = 0; i < numupdates; i++) {
+    size_t total_updates = numupdates + std::max(my_config->NO_MUT_UPDATES(), 0);
+    size_t start_updates = experiment_updates;
+    auto start_time = std::chrono::steady_clock::now();
+    auto progress = [&]() {
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+      return FormatProgress(experiment_updates - start_updates, seconds, total_updates - experiment_updates);
+    };
+
+    for (int i = (int) experiment_updates; i < numupdates; i++) {
       if(verbose && (i%my_config->DATA_INT())==0) {
-        std::cout <<"Update: "<< i << std::endl;
-        std::cout.flush();
+        log <<"Update: "<< i << progress() << std::endl;
       }
       Update();
+      experiment_updates++;
     }
 
     int num_no_mut_updates = my_config->NO_MUT_UPDATES();
@@ -895,15 +1722,321 @@ public:
       SetMutationZero();
     }
 
-    for (int i = 0; i < num_no_mut_updates; i++) {
+    for (int i = (int) experiment_updates - numupdates; i < num_no_mut_updates; i++) {
       if(verbose && (i%my_config->DATA_INT())==0) {
-        std::cout <<"No mutation update: "<< i << std::endl;
-        std::cout.flush();
+        log <<"No mutation update: "<< i << progress() << std::endl;
       }
       Update();
+      experiment_updates++;
+    }
+    experiment_updates = 0;
+  }
+
+
+  /**
+   * Input: The size_t location of the cell to process.
+   *
+   * Output: None
+   *
+   * Purpose: To process the host and the free-living symbiont in a cell,
+   * removing any that have died.
+   */
+  void ProcessCell(size_t i) {
+    if (IsOccupied(i) == false && !sym_pop[i]){ return;} // no organism at that cell
+    if(IsOccupied(i)){//can't call GetDead on a deleted sym, so
+      SYM_PROFILE_PHASE(HOST_PROCESS);
+      pop[i]->Process(i);
+      if (pop[i]->GetDead()) { //Check if the host died
+        DoDeath(i);
+      }
+    }
+    if(sym_pop[i]){ //for sym movement reasons, syms are deleted the update after they are set to dead
+      SYM_PROFILE_PHASE(FREE_SYM_PROCESS);
+      emp::WorldPosition sym_pos = emp::WorldPosition(0,i);
+      OrgRandomPtr::SetSlot(KeyedRandom::FREE_SYM_SLOT);
+      if (sym_pop[i]->GetDead()) DoSymDeath(i); //Might have died since their last time being processed
+      else sym_pop[i]->Process(sym_pos); //index 0, since it's freeliving, and id its location in the world
+    }
+  }
+
+  /**
+   * Input: The size_t location of the cell to process.
+   *
+   * Output: None
+   *
+   * Purpose: The same as ProcessCell(), with the host and free-living symbiont
+   * types and the ECTOSYMBIOSIS and FREE_LIVING_SYMS settings fixed at
+   * compile time, so the organisms' Process() bodies can be inlined without
+   * their feature checks. The host kernel processes its symbionts as SYM_T
+   * too, so the whole resource exchange between them is direct calls.
+   */
+  template <typename HOST_T, typename SYM_T, bool ECTOSYMBIOSIS, bool FREE_LIVING_SYMS>
+  void ProcessCellAs(size_t i) {
+    if (IsOccupied(i) == false && !sym_pop[i]){ return;} // no organism at that cell
+    if(IsOccupied(i)){
+      SYM_PROFILE_PHASE(HOST_PROCESS);
+      emp_assert(typeid(*pop[i]) == typeid(HOST_T));
+      static_cast<HOST_T *>(pop[i].Raw())->template ProcessKernel<ECTOSYMBIOSIS, HOST_T, SYM_T, FREE_LIVING_SYMS>(i);
+      if (pop[i]->GetDead()) { //Check if the host died
+        DoDeath(i);
+      }
+    }
+    if(sym_pop[i]){
+      SYM_PROFILE_PHASE(FREE_SYM_PROCESS);
+      emp::WorldPosition sym_pos = emp::WorldPosition(0,i);
+      OrgRandomPtr::SetSlot(KeyedRandom::FREE_SYM_SLOT);
+      if (sym_pop[i]->GetDead()) DoSymDeath(i);
+      else {
+        emp_assert(typeid(*sym_pop[i]) == typeid(SYM_T));
+        static_cast<SYM_T *>(sym_pop[i].Raw())->template ProcessKernel<FREE_LIVING_SYMS>(sym_pos);
+      }
     }
   }
 
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To fix the host and symbiont types of this world's mode, so that
+   * Update() processes cells with the ProcessCellAs<HOST_T, SYM_T, ...>()
+   * variant matching the current settings. This is decided once for the
+   * world: every host in it must then be exactly a HOST_T and every
+   * symbiont exactly a SYM_T, which debug builds assert cell by cell. Both
+   * types must provide a ProcessKernel() like Host and Symbiont do.
+   */
+  template <typename HOST_T, typename SYM_T>
+  void UseModePolicy() {
+    process_cell_kernels = {
+      &SymWorld::ProcessCellAs<HOST_T, SYM_T, false, false>,
+      &SymWorld::ProcessCellAs<HOST_T, SYM_T, true, false>,
+      &SymWorld::ProcessCellAs<HOST_T, SYM_T, false, true>,
+      &SymWorld::ProcessCellAs<HOST_T, SYM_T, true, true>};
+    ResolveProcessKernel();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To resolve the feature settings the cell kernels are
+   * specialized on, and pick the matching kernel. This runs in Setup() and
+   * at the start of every update, so the organisms' hot paths never check
+   * those settings themselves. It also brings the tag cutoff distribution and
+   * the neighbor table up to date before any (possibly parallel) processing
+   * reads them.
+   */
+  void ResolveProcessKernel() {
+    size_t variant = (size_t) my_config->ECTOSYMBIOSIS() + 2 * (size_t) my_config->FREE_LIVING_SYMS();
+    process_cell_fun = process_cell_kernels[variant];
+    if (my_config->TAG_MATCHING()) GetTagCutoffs();
+    if (IsSpaceStructured()) GetNeighborTable();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether this update should process grid tiles in parallel.
+   *
+   * Purpose: To decide between the serial and the tiled update, (re)building
+   * the tiles and worker threads when needed. Tiling needs a grid that is at
+   * least two tiles wide and tall, and is skipped when phylogenies are tracked
+   * since the systematics are not safe to update from several threads.
+   */
+  bool UseTiledUpdate() {
+    int num_threads = my_config->UPDATE_THREADS();
+    if (num_threads <= 1 || !my_config->GRID() || my_config->PHYLOGENY()) return false;
+
+    if (pop_sizes.size() != 2) return false;
+    const size_t width = GetWidth();
+    const size_t height = GetHeight();
+    const size_t tile_size = std::max(2, my_config->TILE_SIZE());
+    if (width * height != GetSize()) return false;
+
+    // same-colored tiles must stay apart across the grid's wrap-around edges,
+    // so there must be an even number of tiles along each side
+    const size_t tiles_x = 2 * (width / (2 * tile_size));
+    const size_t tiles_y = 2 * (height / (2 * tile_size));
+    if (tiles_x < 2 || tiles_y < 2) return false;
+
+    if (tile_layout != std::array<size_t, 3>{width, height, tile_size}) {
+      tile_layout = {width, height, tile_size};
+      tile_cells.clear();
+      tile_phases.clear();
+      tile_phases.resize(4);
+      tile_randoms.clear();
+      tile_random_pools.clear();
+      tile_keyed_randoms.clear();
+      tile_res.clear();
+      for (size_t ty = 0; ty < tiles_y; ty++) {
+        for (size_t tx = 0; tx < tiles_x; tx++) {
+          emp::vector<size_t> cells;
+          for (size_t y = ty * height / tiles_y; y < (ty + 1) * height / tiles_y; y++) {
+            for (size_t x = tx * width / tiles_x; x < (tx + 1) * width / tiles_x; x++) {
+              cells.push_back(x + y * width);
+            }
+          }
+          tile_phases[tx % 2 + 2 * (ty % 2)].push_back(tile_cells.size());
+          tile_cells.push_back(cells);
+          tile_randoms.emplace_back(1);
+          tile_random_pools.emplace_back();
+          tile_keyed_randoms.emplace_back();
+          tile_res.push_back(0);
+        }
+      }
+    }
+
+    GetUpdatePool(num_threads);
+    return true;
+  }
+
+  /**
+   * Input: The number of threads wanted.
+   *
+   * Output: The world's worker pool, with that many threads.
+   *
+   * Purpose: To get the worker pool, (re)building it when the number of
+   * threads changes.
+   */
+  WorkerPool & GetUpdatePool(size_t num_threads) {
+    if (!update_pool || update_pool->GetNumThreads() != num_threads) {
+      if (update_pool) update_pool.Delete();
+      update_pool = emp::NewPtr<WorkerPool>(num_threads);
+    }
+    return *update_pool;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The scheduler a serial update orders its cells with.
+   *
+   * Purpose: To (re)build the scheduler chosen by the SCHEDULER setting
+   * whenever that setting or SCHEDULE_BLOCK_SIZE changes.
+   */
+  UpdateScheduler & GetScheduler() {
+    std::array<int, 2> settings = {my_config->SCHEDULER(), my_config->SCHEDULE_BLOCK_SIZE()};
+    if (!scheduler || settings != scheduler_settings) {
+      emp::Ptr<UpdateScheduler> new_scheduler;
+      if (settings[0] == 0) new_scheduler = emp::NewPtr<PermutationScheduler>();
+      else if (settings[0] == 1) new_scheduler = emp::NewPtr<BlockedScheduler>(std::max(settings[1], 1));
+      else if (settings[0] == 2) new_scheduler = emp::NewPtr<OccupiedScheduler>(&occupancy);
+      else throw "SCHEDULER must be 0, 1 or 2";
+      if (scheduler) scheduler.Delete();
+      scheduler = new_scheduler;
+      scheduler_settings = settings;
+    }
+    return *scheduler;
+  }
+
+  /**
+   * Input: The keyed generator to process cells with on this thread.
+   *
+   * Output: None
+   *
+   * Purpose: To install a keyed generator, keyed to the seed of the world's
+   * generator, for the cells this thread processes next.
+   */
+  void UseKeyedRandom(KeyedRandom & keyed_random) {
+    keyed_random.SetSeed((uint32_t) emp::World<Organism>::GetRandom().GetSeed());
+    OrgRandomPtr::keyed = &keyed_random;
+  }
+
+  /**
+   * Input: The cell about to be processed.
+   *
+   * Output: None
+   *
+   * Purpose: To address this thread's keyed draws to the cell's host, and
+   * reseed the generator GetRandom() returns until the next cell.
+   */
+  void StartKeyedCell(size_t i) {
+    OrgRandomPtr::keyed->StartCell((uint32_t) update, (uint32_t) i);
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To process every cell in four checkerboard phases. Tiles are at
+   * least two cells wide, so the cells any two tiles of the same phase can
+   * reach (their own plus one ring of neighbors, for births, horizontal
+   * transmission and free-living movement) never overlap, and each phase's
+   * tiles run in parallel. Each tile processes its cells in a random order
+   * using its own generator. The phases run in a random order each update.
+   * With limited resources, the total is split evenly between all tiles
+   * before the first phase and what they leave is pooled again after the
+   * last, so no two tiles pull from the same supply and no phase gets more.
+   */
+  void ProcessTiles() {
+    {
+      SYM_PROFILE_PHASE(SCHEDULE);
+      for (emp::Random & tile_random : tile_randoms) {
+        tile_random.ResetSeed(GetRandom().GetInt(1, std::numeric_limits<int>::max()));
+      }
+      // tiles processed in an earlier phase act first, so no phase may always
+      // be the first
+      emp::Shuffle(GetRandom(), tile_phases);
+    }
+    // organisms record into these nodes while processing, so they must exist
+    // before any tiles run
+    CreateProcessDataNodes();
+
+    const bool use_keyed_random = my_config->KEYED_RANDOM();
+    const bool use_random_pool = my_config->RANDOM_POOL() && !use_keyed_random;
+    const bool limited_res = total_res != -1;
+    if (limited_res) {
+      // every tile gets an even share of the whole update's resources up
+      // front, so no phase has first claim on them; the few left over from
+      // the division go to a run of tiles starting at a random one
+      const int num_tiles = (int) tile_res.size();
+      const int first = GetRandom().GetInt(num_tiles);
+      for (int tile = 0; tile < num_tiles; tile++) {
+        tile_res[tile] = total_res / num_tiles + ((tile - first + num_tiles) % num_tiles < total_res % num_tiles ? 1 : 0);
+      }
+      total_res = 0;
+    }
+    for (emp::vector<size_t> & phase : tile_phases) {
+      update_pool->Run(phase.size(), [this, &phase, use_random_pool, use_keyed_random, limited_res](size_t job) {
+        size_t tile = phase[job];
+        OrgRandomPtr::tile_random = &tile_randoms[tile];
+        if (limited_res) tile_res_budget = &tile_res[tile];
+        try {
+          {
+            SYM_PROFILE_PHASE(SCHEDULE);
+            emp::Shuffle(tile_randoms[tile], tile_cells[tile]);
+          }
+          if (use_random_pool) {
+            tile_random_pools[tile].Reseed(tile_randoms[tile]);
+            OrgRandomPtr::pool = &tile_random_pools[tile];
+          }
+          if (use_keyed_random) UseKeyedRandom(tile_keyed_randoms[tile]);
+          for (size_t i : tile_cells[tile]) {
+            if (use_keyed_random) StartKeyedCell(i);
+            (this->*process_cell_fun)(i);
+          }
+#ifdef SYM_PROFILE
+          profiler.Collect();
+#endif
+        } catch (...) {
+          OrgRandomPtr::tile_random = nullptr;
+          OrgRandomPtr::pool = nullptr;
+          OrgRandomPtr::keyed = nullptr;
+          tile_res_budget = nullptr;
+          throw;
+        }
+        OrgRandomPtr::tile_random = nullptr;
+        OrgRandomPtr::pool = nullptr;
+        OrgRandomPtr::keyed = nullptr;
+        tile_res_budget = nullptr;
+      });
+    }
+    if (limited_res) {
+      for (int res : tile_res) total_res += res;
+    }
+  }
 
   /**
    * Input: None
@@ -913,7 +2046,30 @@ public:
    * Purpose: To simulate a timestep in the world, which includes calling the process functions for hosts and symbionts and updating the data nodes.
    */
   void Update() {
-    emp::World<Organism>::Update();
+    if (resuming_update) {
+      resuming_update = false;
+    } else {
+#ifdef SYM_PROFILE
+      // the profile file writes its row inside emp::World::Update(), so the
+      // next interval starts right after it, and this call's own time counts
+      // towards the next interval
+      bool profile_written = update % (size_t) my_config->DATA_INT() == 0;
+      profiler.Collect();
+      auto world_update_start = std::chrono::steady_clock::now();
+      emp::World<Organism>::Update();
+      if (profile_written) profiler.Reset();
+      UpdateProfiler::AddTime(UpdateProfiler::WORLD_UPDATE, std::chrono::steady_clock::now() - world_update_start);
+#else
+      emp::World<Organism>::Update();
+#endif
+
+      int checkpoint_int = my_config->CHECKPOINT_INT();
+      if (checkpoint_int > 0 && update > 1 && (update - 1) % (size_t) checkpoint_int == 0) {
+        int data_int = my_config->DATA_INT();
+        if (data_int <= 0 || checkpoint_int % data_int != 0) throw "CHECKPOINT_INT must be a multiple of DATA_INT";
+        WriteCheckpoint(GetCheckpointFileName(), true);
+      }
+    }
 
     // Handle resource inflow
     if (total_res != -1) {
@@ -921,36 +2077,60 @@ public:
     }
 
     if(my_config->PHYLOGENY()) {
-      sym_sys->Update(); //sym_sys is not part of the systematics vector, handle it independently
+      {
+        SYM_PROFILE_PHASE(SYSTEMATICS);
+        sym_sys->Update(); //sym_sys is not part of the systematics vector, handle it independently
+      }
 
       if (update % my_config->PHYLOGENY_SNAPSHOT_INTERVAL() == 0) {
+        SYM_PROFILE_PHASE(PHYLOGENY_SNAPSHOT);
         // MapPhylogenyInteractions();
         std::string file_ending = "_UPDATE" + std::to_string(update) + "_SEED"+std::to_string(my_config->SEED())+".data";
         WritePhylogenyFile(my_config->FILE_PATH()+"Phylogeny_"+my_config->FILE_NAME()+file_ending);
       }
     }
-    emp::vector<size_t> schedule = emp::GetPermutation(GetRandom(), GetSize());
-    // divvy up and distribute resources to host and symbiont in each cell
-    for (size_t i : schedule) {
-      if (IsOccupied(i) == false && !sym_pop[i]){ continue;} // no organism at that cell
-      if(IsOccupied(i)){//can't call GetDead on a deleted sym, so
-        pop[i]->Process(i);
-        if (pop[i]->GetDead()) { //Check if the host died
-          DoDeath(i);
-        }
+    ResolveProcessKernel();
+    if (UseTiledUpdate()) {
+      ProcessTiles();
+    } else {
+      const emp::vector<size_t> * schedule;
+      {
+        SYM_PROFILE_PHASE(SCHEDULE);
+        schedule = &GetScheduler().Schedule(GetRandom(), pop, sym_pop);
+      }
+      const bool use_keyed_random = my_config->KEYED_RANDOM();
+      if (use_keyed_random) {
+        UseKeyedRandom(world_keyed_random);
+      } else if (my_config->RANDOM_POOL()) {
+        world_random_pool.Reseed(GetRandom());
+        OrgRandomPtr::pool = &world_random_pool;
       }
-      if(sym_pop[i]){ //for sym movement reasons, syms are deleted the update after they are set to dead
-        emp::WorldPosition sym_pos = emp::WorldPosition(0,i);
-        if (sym_pop[i]->GetDead()) DoSymDeath(i); //Might have died since their last time being processed
-        else sym_pop[i]->Process(sym_pos); //index 0, since it's freeliving, and id its location in the world
+      // divvy up and distribute resources to host and symbiont in each cell
+      try {
+        for (size_t i : *schedule) {
+          if (use_keyed_random) StartKeyedCell(i);
+          (this->*process_cell_fun)(i);
+        }
+      } catch (...) {
+        OrgRandomPtr::pool = nullptr;
+        OrgRandomPtr::keyed = nullptr;
+        throw;
       }
-    } // for each cell in schedule
+      OrgRandomPtr::pool = nullptr;
+      OrgRandomPtr::keyed = nullptr;
+    }
 
     // clean up the graveyard
-    for (size_t i = 0; i < graveyard.size(); i++) {
-      graveyard[i].Delete();
+    {
+      SYM_PROFILE_PHASE(GRAVEYARD);
+      for (size_t i = 0; i < graveyard.size(); i++) {
+        graveyard[i].Delete();
+      }
+      graveyard.clear();
     }
-    graveyard.clear();
+#ifdef SYM_PROFILE
+    profiler.Collect();
+#endif
   } // Update()
 };// SymWorld class
 #endif
@@ -7,6 +7,7 @@
 #include <set>
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
+#include <type_traits>
 
 
 class Symbiont: public Organism {
@@ -80,7 +81,7 @@ protected:
     * Purpose: Represents an instance of random.
     *
   */
-  emp::Ptr<emp::Random> random = NULL;
+  OrgRandomPtr random;
 
   /**
     *
@@ -494,6 +495,7 @@ public:
    * deviation.
    */
   void Mutate(){
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     double local_rate = my_config->MUTATION_RATE();
     double local_size = my_config->MUTATION_SIZE();
 
@@ -510,7 +512,11 @@ public:
       }
     }
     if (my_config->TAG_MATCHING()) {
+      // a symbiont in a placed host is counted in the world's tag frequencies
+      const bool counted = my_host && my_host->IsInWorld();
+      if (counted) my_world->CountSymTag(tag, false);
       tag.FlipRandom(my_world->GetRandom(), my_config->TAG_MUTATION_SIZE());
+      if (counted) my_world->CountSymTag(tag, true);
     }
   }
 
@@ -527,13 +533,30 @@ public:
     if(host == nullptr){
       host = my_host;
     }
+    return ProcessResourcesFrom<Organism>(host_donation, host.Raw());
+  }
+
+  /**
+   * Input: The double representing the resources to be distributed to the symbiont
+   * and the host from whom it comes.
+   *
+   * Output: The double representing the host's resources
+   *
+   * Purpose: The body of ProcessResources(), with the host's type fixed at compile
+   * time so that stealing from it is a direct call. HOST_T must be the host's exact
+   * type, or Organism to call it through the vtable.
+   */
+  template <typename HOST_T>
+  double ProcessResourcesFrom(double host_donation, HOST_T * host){
     double sym_int_val = GetIntVal();
     double sym_portion = 0;
     double host_portion = 0;
     double synergy = my_config->SYNERGY();
 
     if (sym_int_val<0){
-      double stolen = host->StealResources(sym_int_val);
+      double stolen;
+      if constexpr (std::is_same_v<HOST_T, Organism>) stolen = host->StealResources(sym_int_val);
+      else stolen = host->HOST_T::StealResources(sym_int_val);
       host_portion = 0;
       sym_portion = stolen + host_donation;
     }
@@ -609,8 +632,24 @@ public:
    * and to allow for movement
    */
   void Process(emp::WorldPosition location) {
+    if (my_config->FREE_LIVING_SYMS()) ProcessKernel<true>(location);
+    else ProcessKernel<false>(location);
+  }
+
+  /**
+   * Input: The location of the symbiont.
+   *
+   * Output: None
+   *
+   * Purpose: The body of Process(), with the FREE_LIVING_SYMS setting fixed at
+   * compile time. SymWorld calls the right variant directly once it has
+   * resolved the setting for the update, so subclasses that override
+   * Process() must also provide a matching ProcessKernel().
+   */
+  template <bool FREE_LIVING_SYMS>
+  void ProcessKernel(emp::WorldPosition location) {
     //ID is where they are in the world, INDEX is where they are in the host's symbiont list (or 0 if they're free living)
-    if (my_host.IsNull() && my_config->FREE_LIVING_SYMS()) { //free living symbiont
+    if (FREE_LIVING_SYMS && my_host.IsNull()) { //free living symbiont
       double resources = my_world->PullResources(my_config->FREE_SYM_RES_DISTRIBUTE()); //receive resources from the world
       LoseResources(resources);
     }
@@ -624,7 +663,7 @@ public:
       }
     }
     //Check if the organism should move and do it 
-    if (my_host.IsNull() && my_config->FREE_LIVING_SYMS() && !dead) {
+    if (FREE_LIVING_SYMS && my_host.IsNull() && !dead) {
       //if the symbiont should move, and hasn't been killed
       my_world->MoveFreeSym(location);
     }
@@ -644,6 +683,46 @@ public:
     return new_sym;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the symbiont's state to a checkpoint. Its host is
+   * restored by the host that holds it.
+   */
+  void WriteState(CheckpointWriter & out) {
+    out.Write(interaction_val);
+    out.Write(points);
+    out.Write(dead);
+    out.Write(infection_chance);
+    out.Write(age);
+    out.Write(reproductions);
+    out.Write(towards_partner_count);
+    out.Write(from_partner_count);
+    out.WriteBits(tag);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved into a newly
+   * constructed symbiont.
+   */
+  void ReadState(CheckpointReader & in) {
+    in.Read(interaction_val);
+    in.Read(points);
+    in.Read(dead);
+    in.Read(infection_chance);
+    in.Read(age);
+    in.Read(reproductions);
+    in.Read(towards_partner_count);
+    in.Read(from_partner_count);
+    in.ReadBits(tag);
+  }
+
   /**
    * Input: None
    *
@@ -690,12 +769,12 @@ public:
 
       //vertical transmission data node
       emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_verttrans = my_world->GetVerticalTransmissionAttemptCount();
-      data_node_attempts_verttrans.AddDatum(GetIntVal());
+      my_world->RecordDatum(data_node_attempts_verttrans, GetIntVal());
 
       emp::Ptr<Organism> sym_baby = Reproduce();
       if (my_config->TAG_MATCHING()) {
-        double tag_distance = my_world->GetTagMetric()->calculate(host_baby->GetTag(), sym_baby->GetTag())* TAG_LENGTH;
-        double cutoff = random->GetPoisson(my_config->TAG_DISTANCE() * TAG_LENGTH);
+        double tag_distance = PackedTags<TAG_LENGTH>::Distance(host_baby->GetTag(), sym_baby->GetTag());
+        double cutoff = my_world->DrawTagCutoff(random);
         if (tag_distance > cutoff) {
           sym_baby.Delete();
           return;
@@ -703,9 +782,10 @@ public:
       }
       points = points - my_config->SYM_VERT_TRANS_RES();
       host_baby->AddSymbiont(sym_baby);
+      SYM_PROFILE_COUNT(VERT_TRANSMISSIONS);
 
       emp::DataMonitor<double, emp::data::Histogram>& data_node_successes_verttrans = my_world->GetVerticalTransmissionSuccessCount();
-      data_node_successes_verttrans.AddDatum(GetIntVal());
+      my_world->RecordDatum(data_node_successes_verttrans, GetIntVal());
     }
   }
 
@@ -739,10 +819,10 @@ public:
 
         //horizontal transmission data nodes
         emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_horiztrans = my_world->GetHorizontalTransmissionAttemptCount();
-        data_node_attempts_horiztrans.AddDatum(stored_intval);
+        my_world->RecordDatum(data_node_attempts_horiztrans, stored_intval);
         emp::DataMonitor<double, emp::data::Histogram>& data_node_successes_horiztrans = my_world->GetHorizontalTransmissionSuccessCount();
         if(new_pos.IsValid()){
-          data_node_successes_horiztrans.AddDatum(stored_intval);
+          my_world->RecordDatum(data_node_successes_horiztrans, stored_intval);
         }
       }
     }
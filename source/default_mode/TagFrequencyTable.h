@@ -0,0 +1,126 @@
+#ifndef TAG_FREQUENCY_TABLE_H
+#define TAG_FREQUENCY_TABLE_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/bits/BitSet.hpp"
+#include "../ConfigSetup.h"
+#include "../PackedTags.h"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ *
+ * Purpose: Represents how many organisms carry each distinct tag, kept up to
+ * date as tags are added and removed, so richness (the number of distinct
+ * tags) and Shannon entropy can be read without looking at the organisms.
+ *
+ * Entropy is log2(N) - S/N, where N is the number of tags and S is the sum of
+ * c log2(c) over the tag counts c. Each add or remove changes one count, so S
+ * is updated by the difference in that count's term. To keep rounding from
+ * building up, S is recomputed from the counts once there have been more
+ * updates than there are distinct tags, which keeps the cost per update
+ * constant on average.
+ *
+ */
+class TagFrequencyTable {
+public:
+  using tag_t = PackedTags<TAG_LENGTH>::tag_t;
+
+private:
+  struct TagHash {
+    size_t operator()(const tag_t & tag) const {
+      uint64_t hash = 0;
+      for (uint64_t word : tag) {
+        hash ^= word + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      }
+      return (size_t) (hash ^ (hash >> 31));
+    }
+  };
+
+  std::unordered_map<tag_t, size_t, TagHash> counts;
+  size_t num_tags = 0;
+  double sum_c_log_c = 0;
+  size_t updates_since_sum = 0;
+
+  static double CLogC(size_t count) { return count > 1 ? count * std::log2((double) count) : 0.0; }
+
+  void RecomputeSum() {
+    sum_c_log_c = 0;
+    for (const auto & [tag, count] : counts) sum_c_log_c += CLogC(count);
+    updates_since_sum = 0;
+  }
+
+public:
+  /**
+   * Input: The tag of an organism that now counts toward the table.
+   *
+   * Output: None
+   *
+   * Purpose: To count one more organism with this tag.
+   */
+  void Add(const emp::BitSet<TAG_LENGTH> & bits) {
+    size_t & count = counts[PackedTags<TAG_LENGTH>::Pack(bits)];
+    sum_c_log_c += CLogC(count + 1) - CLogC(count);
+    count++;
+    num_tags++;
+    updates_since_sum++;
+  }
+
+  /**
+   * Input: The tag of an organism that no longer counts toward the table.
+   *
+   * Output: None
+   *
+   * Purpose: To count one fewer organism with this tag. Removing a tag that
+   * isn't counted would leave the table wrong, so it throws.
+   */
+  void Remove(const emp::BitSet<TAG_LENGTH> & bits) {
+    auto it = counts.find(PackedTags<TAG_LENGTH>::Pack(bits));
+    if (it == counts.end()) throw "Removing a tag that was never added to the tag frequencies";
+    sum_c_log_c += CLogC(it->second - 1) - CLogC(it->second);
+    if (--it->second == 0) counts.erase(it);
+    num_tags--;
+    updates_since_sum++;
+  }
+
+  void clear() {
+    counts.clear();
+    num_tags = 0;
+    sum_c_log_c = 0;
+    updates_since_sum = 0;
+  }
+
+  size_t GetRichness() const { return counts.size(); }
+  size_t GetNumTags() const { return num_tags; }
+
+  /**
+   * Input: None
+   *
+   * Output: The Shannon entropy, in bits, of the tags' frequencies.
+   *
+   * Purpose: To get the tags' Shannon diversity.
+   */
+  double GetShannonEntropy() {
+    if (num_tags == 0) return 0;
+    if (updates_since_sum > counts.size()) RecomputeSum();
+    const double entropy = std::log2((double) num_tags) - sum_c_log_c / num_tags;
+    return entropy > 0 ? entropy : 0;
+  }
+
+  /**
+   * Input: Every tag that should be in the table.
+   *
+   * Output: Whether the table holds exactly those tags.
+   *
+   * Purpose: To cross-check the table against a scan in debug builds.
+   */
+  bool Matches(const emp::vector<emp::BitSet<TAG_LENGTH>> & tags) const {
+    TagFrequencyTable scanned;
+    for (const emp::BitSet<TAG_LENGTH> & tag : tags) scanned.Add(tag);
+    return scanned.num_tags == num_tags && scanned.counts == counts;
+  }
+};
+
+#endif
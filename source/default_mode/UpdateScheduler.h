@@ -0,0 +1,144 @@
+#ifndef UPDATE_SCHEDULER_H
+#define UPDATE_SCHEDULER_H
+
+#include "../../Empirical/include/emp/base/Ptr.hpp"
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/math/Random.hpp"
+#include "../../Empirical/include/emp/math/random_utils.hpp"
+#include "../Organism.h"
+#include "OccupancyIndex.h"
+
+#include <algorithm>
+
+/**
+ *
+ * Purpose: Represents the order in which a serial update processes the
+ * world's cells. Schedulers keep their order in a buffer they reuse from one
+ * update to the next, so scheduling allocates nothing once the world's size
+ * settles. Every order is drawn only from the generator it is given, so runs
+ * stay reproducible from their seed.
+ *
+ */
+class UpdateScheduler {
+protected:
+  emp::vector<size_t> order;
+
+public:
+  using pop_t = emp::vector<emp::Ptr<Organism>>;
+
+  virtual ~UpdateScheduler() {}
+
+  /**
+   * Input: The world's generator, and its hosts and free-living symbionts by cell.
+   *
+   * Output: The cells to process this update, in order. The reference stays
+   * valid until the next call.
+   *
+   * Purpose: To choose the order cells are processed in this update.
+   */
+  virtual const emp::vector<size_t> & Schedule(emp::Random & random, const pop_t & hosts, const pop_t & free_syms) = 0;
+};
+
+/**
+ *
+ * Purpose: Represents the default schedule: every cell in a uniformly random
+ * order. It draws exactly what emp::GetPermutation() does, so results match
+ * runs made before schedulers existed.
+ *
+ */
+class PermutationScheduler : public UpdateScheduler {
+public:
+  const emp::vector<size_t> & Schedule(emp::Random & random, const pop_t & hosts, const pop_t & free_syms) override {
+    order.resize(hosts.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    emp::Shuffle(random, order);
+    return order;
+  }
+};
+
+/**
+ *
+ * Purpose: Represents a schedule that visits the grid in blocks of
+ * neighboring cells, small enough to stay in cache while they are processed.
+ * The blocks are visited in a random order, and the cells within each block
+ * in a random order, so every cell is still processed exactly once.
+ *
+ */
+class BlockedScheduler : public UpdateScheduler {
+private:
+  size_t block_size;
+  emp::vector<size_t> block_order;
+
+  /**
+   * Input: The generator to draw from, and the range of the order to shuffle.
+   *
+   * Output: None
+   *
+   * Purpose: To shuffle one block of the order in place.
+   */
+  void ShuffleRange(emp::Random & random, size_t start, size_t end) {
+    for (size_t i = start; i + 1 < end; i++) {
+      size_t pos = random.GetUInt(i, end);
+      if (pos != i) std::swap(order[i], order[pos]);
+    }
+  }
+
+public:
+  BlockedScheduler(size_t _block_size) : block_size(std::max(_block_size, (size_t) 1)) {}
+
+  const emp::vector<size_t> & Schedule(emp::Random & random, const pop_t & hosts, const pop_t & free_syms) override {
+    const size_t num_cells = hosts.size();
+    block_order.resize((num_cells + block_size - 1) / block_size);
+    for (size_t i = 0; i < block_order.size(); i++) block_order[i] = i;
+    emp::Shuffle(random, block_order);
+
+    order.resize(num_cells);
+    size_t next = 0;
+    for (size_t block : block_order) {
+      const size_t start = next;
+      for (size_t cell = block * block_size; cell < std::min((block + 1) * block_size, num_cells); cell++) {
+        order[next++] = cell;
+      }
+      ShuffleRange(random, start, next);
+    }
+    return order;
+  }
+};
+
+/**
+ *
+ * Purpose: Represents a schedule of only the cells that hold a host or a
+ * free-living symbiont when the update starts, in a random order. Organisms
+ * born or moved into an empty cell during the update wait until the next
+ * update to be processed, instead of being processed if their cell happens
+ * to come later in the order.
+ *
+ * Given the world's occupancy index, it takes the live cells from there, so
+ * scheduling costs time in the number of organisms rather than the area of
+ * the world; otherwise it scans every cell.
+ *
+ */
+class OccupiedScheduler : public UpdateScheduler {
+private:
+  emp::Ptr<OccupancyIndex> occupancy;
+
+public:
+  OccupiedScheduler(emp::Ptr<OccupancyIndex> _occupancy = nullptr) : occupancy(_occupancy) {}
+
+  const emp::vector<size_t> & Schedule(emp::Random & random, const pop_t & hosts, const pop_t & free_syms) override {
+    if (occupancy) {
+      // sorted, so the order drawn matches a scan of every cell
+      order.assign(occupancy->GetCells().begin(), occupancy->GetCells().end());
+      std::sort(order.begin(), order.end());
+    } else {
+      order.clear();
+      for (size_t i = 0; i < hosts.size(); i++) {
+        if (hosts[i] || (i < free_syms.size() && free_syms[i])) order.push_back(i);
+      }
+    }
+    emp::Shuffle(random, order);
+    return order;
+  }
+};
+
+#endif
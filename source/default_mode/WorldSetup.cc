@@ -70,5 +70,21 @@ void SymWorld::Setup() {
   Resize(my_config->GRID_X(), my_config->GRID_Y());
   long unsigned int total_syms = POP_SIZE * start_moi;
   SetupSymbionts(&total_syms);
+
+  ResolveProcessKernel();
 }
+/**
+ * Input: The type name an organism was saved under in a checkpoint.
+ *
+ * Output: A new organism of that type, to read the saved state into.
+ *
+ * Purpose: To recreate the organisms of a checkpoint. Worlds with their own
+ * organism types extend this.
+ */
+emp::Ptr<Organism> SymWorld::NewCheckpointOrg(const std::string & name) {
+  if (name == "Host") return emp::NewPtr<Host>(&GetRandom(), this, my_config);
+  if (name == "Symbiont") return emp::NewPtr<Symbiont>(&GetRandom(), this, my_config);
+  throw "Checkpoint has an organism type this world can't create";
+}
+
 #endif
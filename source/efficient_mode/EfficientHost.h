@@ -4,7 +4,7 @@
 #include "../default_mode/Host.h"
 #include "EfficientWorld.h"
 
-class EfficientHost: public Host {
+class EfficientHost final: public Host {
 protected:
 
   /**
@@ -116,5 +116,29 @@ public:
     host_baby->SetEfficiency(GetEfficiency());
     return host_baby;
   }
+
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the efficient host's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Host::WriteState(out);
+    out.Write(efficiency);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Host::ReadState(in);
+    in.Read(efficiency);
+  }
 };
 #endif
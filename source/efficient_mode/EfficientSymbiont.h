@@ -7,7 +7,7 @@
 
 
 
-class EfficientSymbiont: public Symbiont {
+class EfficientSymbiont final: public Symbiont {
 protected:
 
   /**
@@ -162,6 +162,7 @@ public:
   #pragma clang diagnostic push
   #pragma clang diagnostic ignored "-Woverloaded-virtual"
   void Mutate(std::string mode){
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     double local_size;
     double local_rate;
     double int_rate;
@@ -224,6 +225,36 @@ public:
     return sym_baby;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the efficient symbiont's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Symbiont::WriteState(out);
+    out.Write(efficiency);
+    out.Write(ht_mut_size);
+    out.Write(ht_mut_rate);
+    out.Write(eff_mut_rate);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Symbiont::ReadState(in);
+    in.Read(efficiency);
+    in.Read(ht_mut_size);
+    in.Read(ht_mut_rate);
+    in.Read(eff_mut_rate);
+  }
+
   /**
    * Input: String to indicate the mode of transmission, either vertical or horizontal
    *
@@ -252,10 +283,11 @@ public:
     if((my_world->WillTransmit()) && GetPoints() >= efficient_config->SYM_VERT_TRANS_RES()){ //if the world permits vertical tranmission and the sym has enough resources, transmit!
       emp::Ptr<Organism> sym_baby = Reproduce("vertical");
       host_baby->AddSymbiont(sym_baby);
+      SYM_PROFILE_COUNT(VERT_TRANSMISSIONS);
 
       //vertical transmission data node
       emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_verttrans = my_world->GetVerticalTransmissionAttemptCount();
-      data_node_attempts_verttrans.AddDatum(GetIntVal());
+      my_world->RecordDatum(data_node_attempts_verttrans, GetIntVal());
     }
   }
 
@@ -277,11 +309,11 @@ public:
 
         //horizontal transmission data nodes
         emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_horiztrans = my_world->GetHorizontalTransmissionAttemptCount();
-        data_node_attempts_horiztrans.AddDatum(GetIntVal());
+        my_world->RecordDatum(data_node_attempts_horiztrans, GetIntVal());
 
         emp::DataMonitor<double, emp::data::Histogram>& data_node_successes_horiztrans = my_world->GetHorizontalTransmissionSuccessCount();
         if(new_pos.IsValid()){
-          data_node_successes_horiztrans.AddDatum(GetIntVal());
+          my_world->RecordDatum(data_node_successes_horiztrans, GetIntVal());
         }
       }
     }
@@ -51,6 +51,7 @@ public:
   void Setup();
   void SetupHosts(long unsigned int* POP_SIZE);
   void SetupSymbionts(long unsigned int* total_syms);
+  emp::Ptr<Organism> NewCheckpointOrg(const std::string & name);
 
 
   /**
@@ -96,22 +97,22 @@ public:
   emp::DataMonitor<double>& GetEfficiencyDataNode() {
     if (!data_node_efficiency) {
       data_node_efficiency.New();
-      OnUpdate([this](size_t){
+      size_t column = AddSymCensusColumn([](emp::Ptr<Organism> sym){ return sym->GetEfficiency(); });
+      AddDataNodeScan({&data_node_efficiency}, [this, column](){
         data_node_efficiency->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            size_t sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_efficiency->AddDatum(syms[j]->GetEfficiency());
-            }//close for
+        const PopulationStore & store = GetPopulationStore();
+        for (double efficiency : store.GetHostedSymColumn(column)) {
+          data_node_efficiency->AddDatum(efficiency);
+        }//close for
+        const emp::vector<double> & free_efficiencies = store.GetFreeSymColumn(column);
+        for (size_t i : store.live_cells) {
+          if(store.free_sym_present[i]) {
+            data_node_efficiency->AddDatum(free_efficiencies[i]);
           }//close if
-          if(sym_pop[i]) {
-            data_node_efficiency->AddDatum(sym_pop[i]->GetEfficiency());
-          }//close if
-      }//close for
+        }//close for
       });
     }
+    RefreshDataNode(&data_node_efficiency);
     return *data_node_efficiency;
   }
 
@@ -46,4 +46,17 @@ void EfficientWorld::Setup() {
   if (efficient_config->EFFICIENCY_MUT_RATE() == -1) efficient_config->EFFICIENCY_MUT_RATE(efficient_config->HORIZ_MUTATION_RATE());
   SymWorld::Setup();
 }
+/**
+ * Input: The type name an organism was saved under in a checkpoint.
+ *
+ * Output: A new organism of that type, to read the saved state into.
+ *
+ * Purpose: To recreate the efficient hosts and symbionts of a checkpoint.
+ */
+emp::Ptr<Organism> EfficientWorld::NewCheckpointOrg(const std::string & name) {
+  if (name == "EfficientHost") return emp::NewPtr<EfficientHost>(&GetRandom(), this, efficient_config);
+  if (name == "EfficientSymbiont") return emp::NewPtr<EfficientSymbiont>(&GetRandom(), this, efficient_config);
+  return SymWorld::NewCheckpointOrg(name);
+}
+
 #endif
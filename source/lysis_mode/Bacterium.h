@@ -5,7 +5,7 @@
 #include "LysisWorld.h"
 
 
-class Bacterium : public Host {
+class Bacterium final : public Host {
 
 
 protected:
@@ -123,6 +123,30 @@ public:
     return host_baby;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the bacterium's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Host::WriteState(out);
+    out.Write(host_incorporation_val);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Host::ReadState(in);
+    in.Read(host_incorporation_val);
+  }
+
   /**
    * Input: None
    *
@@ -133,6 +157,7 @@ public:
    * is equal to the mutation size. Bacterium mutation can be turned on or off.
    */
   void Mutate() {
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     Host::Mutate();
 
     if(random->GetDouble(0.0, 1.0) <= lysis_config->MUTATION_RATE()){
@@ -62,6 +62,7 @@ public:
    */
   void SetupHosts(long unsigned int* POP_SIZE);
   void SetupSymbionts(long unsigned int* total_syms);
+  emp::Ptr<Organism> NewCheckpointOrg(const std::string & name);
 
 
   /**
@@ -79,6 +80,20 @@ public:
     SetupIncorporationDifferenceFile(lysis_config->FILE_PATH()+"IncValDifferences"+lysis_config->FILE_NAME()+file_ending).SetTimingRepeat(lysis_config->DATA_INT());
   }
 
+  /**
+  * Input: None.
+  *
+  * Output: None.
+  *
+  * Purpose: To create the data nodes that phage record into while they are
+  * being processed, in addition to the SymWorld ones.
+  */
+  void CreateProcessDataNodes(){
+    SymWorld::CreateProcessDataNodes();
+    GetBurstSizeDataNode();
+    GetBurstCountDataNode();
+  }
+
   /**
    * Input: The Empirical DataFile object tracking data nodes.
    *
@@ -86,7 +101,7 @@ public:
    *
    * Purpose: To add bacterium data nodes to be tracked to the bacterium data file.
    */
-  void SetupHostFileColumns(emp::DataFile & file){
+  void SetupHostFileColumns(ColumnarDataFile & file){
     SymWorld::SetupHostFileColumns(file);
     auto & cfu_node = GetCFUDataNode();
     file.AddTotal(cfu_node, "cfu_count", "Total number of colony forming units"); //colony forming units are hosts that
@@ -206,22 +221,22 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetLysisChanceDataNode() {
     if (!data_node_lysischance) {
       data_node_lysischance.New();
-      OnUpdate([this](size_t){
+      size_t column = AddSymCensusColumn([](emp::Ptr<Organism> sym){ return sym->GetLysisChance(); });
+      AddDataNodeScan({&data_node_lysischance}, [this, column](){
         data_node_lysischance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_lysischance->AddDatum(syms[j]->GetLysisChance());
-            }//close for
-          }//close if
-          if (sym_pop[i]){
-            data_node_lysischance->AddDatum(sym_pop[i]->GetLysisChance());
+        const PopulationStore & store = GetPopulationStore();
+        for (double value : store.GetHostedSymColumn(column)) {
+          data_node_lysischance->AddDatum(value);
+        }
+        const emp::vector<double> & free_values = store.GetFreeSymColumn(column);
+        for (size_t i : store.live_cells) {
+          if (store.free_sym_present[i]) {
+            data_node_lysischance->AddDatum(free_values[i]);
           }
         }//close for
       });
     }
+    RefreshDataNode(&data_node_lysischance);
     data_node_lysischance->SetupBins(0, 1.1, 11);
     return *data_node_lysischance;
   }
@@ -271,22 +286,22 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetInductionChanceDataNode() {
     if (!data_node_inductionchance) {
       data_node_inductionchance.New();
-      OnUpdate([this](size_t){
+      size_t column = AddSymCensusColumn([](emp::Ptr<Organism> sym){ return sym->GetInductionChance(); });
+      AddDataNodeScan({&data_node_inductionchance}, [this, column](){
         data_node_inductionchance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_inductionchance->AddDatum(syms[j]->GetInductionChance());
-            }//close for
-          }//close if
-          if (sym_pop[i]){
-            data_node_inductionchance->AddDatum(sym_pop[i]->GetInductionChance());
+        const PopulationStore & store = GetPopulationStore();
+        for (double value : store.GetHostedSymColumn(column)) {
+          data_node_inductionchance->AddDatum(value);
+        }
+        const emp::vector<double> & free_values = store.GetFreeSymColumn(column);
+        for (size_t i : store.live_cells) {
+          if (store.free_sym_present[i]) {
+            data_node_inductionchance->AddDatum(free_values[i]);
           }
         }//close for
       });
     }
+    RefreshDataNode(&data_node_inductionchance);
     data_node_inductionchance->SetupBins(0, 1.1, 11);
     return *data_node_inductionchance;
   }
@@ -303,22 +318,26 @@ public:
   emp::DataMonitor<double,emp::data::Histogram>& GetIncorporationDifferenceDataNode() {
     if (!data_node_incorporation_difference) {
       data_node_incorporation_difference.New();
-      OnUpdate([this](size_t){
+      auto inc_val = [](emp::Ptr<Organism> org){ return org->GetIncVal(); };
+      size_t host_column = AddHostCensusColumn(inc_val);
+      size_t sym_column = AddSymCensusColumn(inc_val, false);
+      AddDataNodeScan({&data_node_incorporation_difference}, [this, host_column, sym_column](){
         data_node_incorporation_difference->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            double host_inc_val = pop[i]->GetIncVal();
-
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            long unsigned int sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              double inc_val_difference = abs(host_inc_val - syms[j]->GetIncVal());
+        const PopulationStore & store = GetPopulationStore();
+        const emp::vector<double> & host_inc_vals = store.GetHostColumn(host_column);
+        const emp::vector<double> & sym_inc_vals = store.GetHostedSymColumn(sym_column);
+        for (size_t i : store.live_cells) {
+          if (store.occupied[i]) {
+            double host_inc_val = host_inc_vals[i];
+            for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+              double inc_val_difference = abs(host_inc_val - sym_inc_vals[j]);
               data_node_incorporation_difference->AddDatum(inc_val_difference);
             }
           }//close if
         }//close for
       });
     }
+    RefreshDataNode(&data_node_incorporation_difference);
     data_node_incorporation_difference->SetupBins(0, 1.1, 11);
     return *data_node_incorporation_difference;
   }
@@ -336,33 +355,29 @@ public:
     //keep track of host organisms that are uninfected or infected with only lysogenic phage
     if(!data_node_cfu) {
       data_node_cfu.New();
-      OnUpdate([this](size_t){
+      size_t lytic_column = AddSymCensusColumn([](emp::Ptr<Organism> sym){
+        return (double) (sym->IsPhage() && sym->GetLysogeny() == false);
+      }, false);
+      AddDataNodeScan({&data_node_cfu}, [this, lytic_column](){
         data_node_cfu -> Reset();
 
-        for (size_t i = 0; i < pop.size(); i++) {
-          if(IsOccupied(i)) {
-            //uninfected hosts
-            if((pop[i]->GetSymbionts()).empty()) {
-              data_node_cfu->AddDatum(1);
+        const PopulationStore & store = GetPopulationStore();
+        const emp::vector<double> & lytic = store.GetHostedSymColumn(lytic_column);
+        for (size_t i : store.live_cells) {
+          if(store.occupied[i]) {
+            //uninfected hosts, and infected hosts whose symbionts are all lysogenic
+            bool all_lysogenic = true;
+            for (size_t j = store.sym_start[i]; j < store.sym_start[i+1]; j++) {
+              if (lytic[j]) all_lysogenic = false;
             }
-
-            //infected hosts, check if all symbionts are lysogenic
-            if(pop[i]->HasSym()) {
-              emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-              bool all_lysogenic = true;
-              for(long unsigned int j = 0; j < syms.size(); j++){
-                if(syms[j]->IsPhage() && syms[j]->GetLysogeny() == false){
-                  all_lysogenic = false;
-                }
-              }
-              if(all_lysogenic){
-                data_node_cfu->AddDatum(1);
-              }
+            if(all_lysogenic){
+              data_node_cfu->AddDatum(1);
             }
           } //endif
         } //end for
-      }); //end OnUpdate
+      }); //end AddDataNodeScan
     } //end if
+    RefreshDataNode(&data_node_cfu);
     return *data_node_cfu;
   }
 
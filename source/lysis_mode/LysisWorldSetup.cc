@@ -39,4 +39,17 @@ void LysisWorld::SetupSymbionts(long unsigned int* total_syms) {
   }
 }
 
+/**
+ * Input: The type name an organism was saved under in a checkpoint.
+ *
+ * Output: A new organism of that type, to read the saved state into.
+ *
+ * Purpose: To recreate the bacteria and phage of a checkpoint.
+ */
+emp::Ptr<Organism> LysisWorld::NewCheckpointOrg(const std::string & name) {
+  if (name == "Bacterium") return emp::NewPtr<Bacterium>(&GetRandom(), this, lysis_config);
+  if (name == "Phage") return emp::NewPtr<Phage>(&GetRandom(), this, lysis_config);
+  return SymWorld::NewCheckpointOrg(name);
+}
+
 #endif
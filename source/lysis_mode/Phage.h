@@ -4,7 +4,7 @@
 #include "../default_mode/Symbiont.h"
 #include "LysisWorld.h"
 
-class Phage: public Symbiont {
+class Phage final: public Symbiont {
 protected:
 
   /**
@@ -255,6 +255,7 @@ public:
    * on or off.
    */
   void Mutate() {
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     Symbiont::Mutate();
     double local_rate = lysis_config->MUTATION_RATE();
     double local_size = lysis_config->MUTATION_SIZE();
@@ -295,6 +296,38 @@ public:
     return sym_baby;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the phage's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Symbiont::WriteState(out);
+    out.Write(burst_timer);
+    out.Write(lysogeny);
+    out.Write(incorporation_val);
+    out.Write(chance_of_lysis);
+    out.Write(induction_chance);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Symbiont::ReadState(in);
+    in.Read(burst_timer);
+    in.Read(lysogeny);
+    in.Read(incorporation_val);
+    in.Read(chance_of_lysis);
+    in.Read(induction_chance);
+  }
+
   /**
    * Input: location of the phage attempting to horizontally transmit
    *
@@ -303,12 +336,13 @@ public:
    * Purpose: To burst host and release offspring
    */
   void LysisBurst(emp::WorldPosition location){
-    emp::vector<emp::Ptr<Organism>>& repro_syms = my_host->GetReproSymbionts();
+    SymbiontList& repro_syms = my_host->GetReproSymbionts();
     //Record the burst size and count
     emp::DataMonitor<double>& data_node_burst_size = my_world->GetBurstSizeDataNode();
-    data_node_burst_size.AddDatum(repro_syms.size());
+    my_world->RecordDatum(data_node_burst_size, repro_syms.size());
     emp::DataMonitor<int>& data_node_burst_count = my_world->GetBurstCountDataNode();
-    data_node_burst_count.AddDatum(1);
+    my_world->RecordDatum(data_node_burst_count, 1);
+    SYM_PROFILE_COUNT(LYSIS_BURSTS);
     emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_horiztrans = my_world->GetHorizontalTransmissionAttemptCount();
     emp::DataMonitor<double, emp::data::Histogram>& data_node_successes_horiztrans = my_world->GetHorizontalTransmissionSuccessCount();
 
@@ -316,9 +350,9 @@ public:
       emp::WorldPosition new_pos = my_world->SymDoBirth(repro_syms[r], location);
 
       //horizontal transmission data nodes
-      data_node_attempts_horiztrans.AddDatum(GetIntVal());
+      my_world->RecordDatum(data_node_attempts_horiztrans, GetIntVal());
       if(new_pos.IsValid()){
-        data_node_successes_horiztrans.AddDatum(GetIntVal());
+        my_world->RecordDatum(data_node_successes_horiztrans, GetIntVal());
       }
     }
     my_host->ClearReproSyms();
@@ -361,10 +395,11 @@ public:
     if(lysogeny){
       emp::Ptr<Organism> phage_baby = Reproduce();
       host_baby->AddSymbiont(phage_baby);
+      SYM_PROFILE_COUNT(VERT_TRANSMISSIONS);
 
       //vertical transmission data node
       emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_verttrans = my_world->GetVerticalTransmissionAttemptCount();
-      data_node_attempts_verttrans.AddDatum(GetIntVal());
+      my_world->RecordDatum(data_node_attempts_verttrans, GetIntVal());
     }
   }
 
@@ -383,6 +418,21 @@ public:
     if(host == nullptr){
       host = my_host;
     }
+    return ProcessResourcesFrom<Organism>(host_donation, host.Raw());
+  }
+
+  /**
+   * Input: The double representing the resources to be distributed to the phage
+   * and the host from whom it comes.
+   *
+   * Output: The double representing the resources that are left over from what
+   * was distributed to the phage.
+   *
+   * Purpose: The body of ProcessResources(), with the host's type fixed at compile
+   * time as in Symbiont::ProcessResourcesFrom().
+   */
+  template <typename HOST_T>
+  double ProcessResourcesFrom(double host_donation, HOST_T * host){
     if(lysogeny){
       if(lysis_config->BENEFIT_TO_HOST()){
         return host->ProcessLysogenResources(incorporation_val);
@@ -391,7 +441,7 @@ public:
       }
     }
     else{
-      return Symbiont::ProcessResources(host_donation, host); //lytic phage do steal resources
+      return Symbiont::ProcessResourcesFrom<HOST_T>(host_donation, host); //lytic phage do steal resources
     }
   }
 
@@ -403,6 +453,19 @@ public:
    * Purpose: To process a phage, meaning check for reproduction, check for lysis, and move the phage.
    */
   void Process(emp::WorldPosition location) {
+    if (lysis_config->FREE_LIVING_SYMS()) ProcessKernel<true>(location);
+    else ProcessKernel<false>(location);
+  }
+
+  /**
+   * Input: The worldposition representing the location of the phage being processed.
+   *
+   * Output: None
+   *
+   * Purpose: The body of Process(), with the FREE_LIVING_SYMS setting fixed at compile time.
+   */
+  template <bool FREE_LIVING_SYMS>
+  void ProcessKernel(emp::WorldPosition location) {
     if(lysis_config->LYSIS() && !GetHost().IsNull()) { //lysis enabled and phage is in a host
       if(!lysogeny){ //phage has chosen lysis
         if(GetBurstTimer() >= lysis_config->BURST_TIME() ) { //time to lyse!
@@ -423,7 +486,7 @@ public:
       }
     }
 
-    else if (GetHost().IsNull() && lysis_config->FREE_LIVING_SYMS()) { //phage is free living
+    else if (FREE_LIVING_SYMS && GetHost().IsNull()) { //phage is free living
       my_world->MoveFreeSym(location);
     }
   }
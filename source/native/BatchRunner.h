@@ -0,0 +1,224 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../ConfigSetup.h"
+#include "../WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ *
+ * Purpose: Represents one line of a sweep file: a setting and the values
+ * the batch should run it with.
+ *
+ */
+struct SweepSetting {
+  std::string name;
+  emp::vector<std::string> values;
+};
+
+/**
+ *
+ * Purpose: Represents one replicate of a batch: the value each swept setting
+ * takes in it, and how long it is expected to run relative to the others.
+ *
+ */
+struct BatchReplicate {
+  emp::vector<std::pair<std::string, std::string>> settings;
+  std::string file_name_suffix; // tells apart treatments that share a seed
+  double expected_cost = 0;
+};
+
+/**
+ * Input: The name of a sweep file, and the config whose settings it sweeps.
+ *
+ * Output: The swept settings, in the order they appear in the file.
+ *
+ * Purpose: To read a sweep file. Each line names a setting followed by the
+ * values to run it with, and lines that are blank or start with # are
+ * skipped. A value written FIRST:END stands for every whole number from FIRST
+ * up to, but not including, END, so "SEED 10:21" runs the same seeds as
+ * stats_scripts/simple_repeat.py.
+ */
+emp::vector<SweepSetting> ReadSweepFile(const std::string & filename, const SymConfigBase & config) {
+  std::ifstream in(filename);
+  if (!in) throw "Could not open the BATCH_FILE sweep file";
+
+  emp::vector<SweepSetting> sweep;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::stringstream words(line);
+    SweepSetting setting;
+    if (!(words >> setting.name) || setting.name[0] == '#') continue;
+    if (!config.Has(setting.name)) throw "The BATCH_FILE sweep file names a setting that doesn't exist";
+    if (setting.name == "BATCH_FILE" || setting.name == "BATCH_THREADS") throw "The BATCH_FILE sweep file can't sweep the batch settings";
+
+    std::string value;
+    while (words >> value) {
+      size_t colon = value.find(':');
+      if (colon == std::string::npos) {
+        setting.values.push_back(value);
+        continue;
+      }
+      long long first, end;
+      try {
+        first = std::stoll(value.substr(0, colon));
+        end = std::stoll(value.substr(colon + 1));
+      } catch (const std::exception &) {
+        throw "A range in the BATCH_FILE sweep file must be written FIRST:END with whole numbers";
+      }
+      for (long long i = first; i < end; i++) setting.values.push_back(std::to_string(i));
+    }
+    if (setting.values.size() == 0) throw "Every setting in the BATCH_FILE sweep file needs at least one value";
+    sweep.push_back(setting);
+  }
+  return sweep;
+}
+
+/**
+ * Input: The swept settings.
+ *
+ * Output: One replicate for every combination of the settings' values.
+ *
+ * Purpose: To expand a sweep into its replicates. Settings that take more
+ * than one value (other than SEED and the output paths, which are already part
+ * of every file name) are appended to FILE_NAME, so that each treatment
+ * writes its own files.
+ */
+emp::vector<BatchReplicate> ExpandSweep(const emp::vector<SweepSetting> & sweep) {
+  emp::vector<BatchReplicate> replicates;
+  emp::vector<size_t> choice(sweep.size(), 0);
+  while (true) {
+    BatchReplicate replicate;
+    for (size_t i = 0; i < sweep.size(); i++) {
+      const std::string & name = sweep[i].name;
+      const std::string & value = sweep[i].values[choice[i]];
+      replicate.settings.emplace_back(name, value);
+      if (sweep[i].values.size() > 1 && name != "SEED" && name != "FILE_NAME" && name != "FILE_PATH") {
+        replicate.file_name_suffix += "_" + name + value;
+      }
+    }
+    replicates.push_back(replicate);
+
+    // count through the combinations with the last setting changing fastest
+    size_t i = sweep.size();
+    while (i > 0 && ++choice[i - 1] == sweep[i - 1].values.size()) {
+      choice[i - 1] = 0;
+      i--;
+    }
+    if (i == 0) return replicates;
+  }
+}
+
+/**
+ * Input: The config of a replicate.
+ *
+ * Output: A rough measure of how long the replicate will take to run.
+ *
+ * Purpose: To order a batch so that the longest replicates start first. Each
+ * update costs about as much as there are organisms in the world, which grows
+ * with the world's size and the starting number of symbionts per host.
+ */
+double ExpectedReplicateCost(SymConfigBase & config) {
+  double updates = config.UPDATES() + std::max(config.NO_MUT_UPDATES(), 0);
+  double cells = (double) config.GRID_X() * config.GRID_Y();
+  return updates * cells * (1 + std::max(config.START_MOI(), 0.0));
+}
+
+/**
+ * Input: The config the batch was started with, and the function that runs a
+ * single replicate given its config and the stream to report progress to.
+ *
+ * Output: 0 if every replicate finished, or 1 if any failed.
+ *
+ * Purpose: To run every replicate of the BATCH_FILE sweep within this
+ * process. Each replicate gets its own config, random number generator and
+ * world, starting from the settings the batch was given. Replicates run
+ * BATCH_THREADS at a time, longest expected first, so the short ones fill in
+ * around the long ones at the end. What a single run would print goes to
+ * Output<FILE_NAME>_SEED<SEED>.data beside the replicate's other files.
+ */
+template <typename CONFIG_T>
+int RunBatch(CONFIG_T & config, std::function<void(CONFIG_T &, std::ostream &)> run_replicate) {
+  emp::vector<BatchReplicate> replicates = ExpandSweep(ReadSweepFile(config.BATCH_FILE(), config));
+
+  std::stringstream base_settings;
+  config.Write(base_settings);
+  auto setup_config = [&](CONFIG_T & replicate_config, const BatchReplicate & replicate) {
+    std::stringstream settings(base_settings.str());
+    replicate_config.Read(settings);
+    replicate_config.Set("BATCH_FILE", "");
+    for (const auto & [name, value] : replicate.settings) replicate_config.Set(name, value);
+    replicate_config.Set("FILE_NAME", replicate_config.FILE_NAME() + replicate.file_name_suffix);
+  };
+
+  for (BatchReplicate & replicate : replicates) {
+    CONFIG_T replicate_config;
+    setup_config(replicate_config, replicate);
+    replicate.expected_cost = ExpectedReplicateCost(replicate_config);
+  }
+  std::stable_sort(replicates.begin(), replicates.end(),
+    [](const BatchReplicate & a, const BatchReplicate & b) { return a.expected_cost > b.expected_cost; });
+
+  size_t num_threads = config.BATCH_THREADS();
+  if (config.BATCH_THREADS() <= 0) {
+    // replicates that split their grid into tiles already use several threads each
+    size_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    num_threads = std::max(hardware_threads / (size_t) std::max(config.UPDATE_THREADS(), 1), (size_t) 1);
+  }
+  num_threads = std::min(num_threads, replicates.size());
+
+  std::cout << "Running " << replicates.size() << " replicates, " << num_threads << " at a time" << std::endl;
+
+  std::mutex report_mutex;
+  size_t finished = 0;
+  size_t failed = 0;
+  WorkerPool pool(num_threads);
+  pool.Run(replicates.size(), [&](size_t i) {
+    auto start = std::chrono::steady_clock::now();
+    CONFIG_T replicate_config;
+    setup_config(replicate_config, replicates[i]);
+    std::string name = replicate_config.FILE_NAME() + "_SEED" + std::to_string(replicate_config.SEED());
+
+    std::string error;
+    try {
+      std::ofstream log(replicate_config.FILE_PATH() + "Output" + name + ".data");
+      if (!log) throw "Could not open the replicate's output file";
+      replicate_config.Write(log);
+      run_replicate(replicate_config, log);
+    } catch (const char * message) {
+      error = message;
+    } catch (const std::exception & e) {
+      error = e.what();
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    std::lock_guard<std::mutex> lock(report_mutex);
+    finished++;
+    std::cout << "[" << finished << "/" << replicates.size() << "] " << name;
+    if (error == "") {
+      std::cout << " finished in " << seconds.count() << "s" << std::endl;
+    } else {
+      failed++;
+      std::cout << " failed: " << error << std::endl;
+    }
+  });
+
+  if (failed > 0) {
+    std::cerr << failed << " of " << replicates.size() << " replicates failed." << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "../../Empirical/include/emp/config/config.hpp"
 #include <iostream>
 #include "../ConfigSetup.h"
+#include "BatchRunner.h"
 
 /**
  * Input: The SymConfig object and the command line arguments.
@@ -0,0 +1,334 @@
+#include "../default_mode/WorldSetup.cc"
+#include "../lysis_mode/LysisWorldSetup.cc"
+#include "../pgg_mode/PGGWorldSetup.cc"
+#include "../efficient_mode/EfficientWorldSetup.cc"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <utility>
+
+/**
+ *
+ * Purpose: Represents one benchmark scenario: the mode it runs in and the
+ * settings it changes from their defaults. Scenarios never read
+ * SymSettings.cfg, so results stay comparable from one build to the next.
+ *
+ */
+struct BenchScenario {
+  std::string name;
+  std::string mode;
+  emp::vector<std::pair<std::string, std::string>> settings;
+};
+
+/**
+ *
+ * Purpose: Represents the measurements from running one scenario at one grid
+ * size.
+ *
+ */
+struct BenchResult {
+  size_t updates = 0;
+  double organism_updates = 0; // organisms alive at the start of each update, summed
+  double setup_seconds = 0;
+  double update_seconds = 0;
+  double finish_seconds = 0;
+  long peak_rss_kb = 0;
+};
+
+const emp::vector<BenchScenario> BENCH_SCENARIOS = {
+  {"default_mixed", "default", {}},
+  {"default_mixed_random_pool", "default", {{"RANDOM_POOL", "1"}}},
+  {"default_mixed_keyed_random", "default", {{"KEYED_RANDOM", "1"}}},
+  {"default_grid", "default", {{"GRID", "1"}}},
+  {"grid_blocked_schedule", "default", {{"GRID", "1"}, {"SCHEDULER", "1"}}},
+  {"sparse_grid", "default", {{"GRID", "1"}, {"HOST_AGE_MAX", "5"}, {"SYM_AGE_MAX", "5"}}},
+  {"sparse_grid_occupied_schedule", "default", {{"GRID", "1"}, {"HOST_AGE_MAX", "5"}, {"SYM_AGE_MAX", "5"}, {"SCHEDULER", "2"}}},
+  {"free_living_movement", "default", {{"GRID", "1"}, {"FREE_LIVING_SYMS", "1"}, {"MOVE_FREE_SYMS", "1"}, {"FREE_SYM_RES_DISTRIBUTE", "50"}}},
+  {"ectosymbiosis", "default", {{"FREE_LIVING_SYMS", "1"}, {"ECTOSYMBIOSIS", "1"}, {"FREE_SYM_RES_DISTRIBUTE", "50"}}},
+  {"tag_matching", "default", {{"TAG_MATCHING", "1"}, {"STARTING_TAGS_ONE_PROB", "0.5"}}},
+  {"phylogeny_interactions", "default", {{"PHYLOGENY", "1"}, {"TRACK_PHYLOGENY_INTERACTIONS", "1"}}},
+  {"lysis_bursts", "lysis", {{"LYSIS", "1"}, {"LYSIS_CHANCE", "0.5"}, {"SYM_LYSIS_RES", "10"}}},
+  {"pgg_multi_infection", "pgg", {{"PGG", "1"}, {"SYM_LIMIT", "3"}, {"START_MOI", "2"}, {"PGG_DONATE", "0.1"}}},
+  {"efficient", "efficient", {{"EFFICIENT_SYM", "1"}}},
+};
+
+/**
+ * Input: None
+ *
+ * Output: None
+ *
+ * Purpose: To start measuring peak memory afresh for the next scenario. On
+ * Linux this resets the process's high-water mark; elsewhere the peak
+ * carries over from earlier scenarios.
+ */
+void ResetPeakMemory() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if (clear_refs) clear_refs << "5";
+}
+
+/**
+ * Input: None
+ *
+ * Output: The most resident memory, in kilobytes, the process has used since
+ * ResetPeakMemory() was last called.
+ *
+ * Purpose: To measure the memory a scenario needs.
+ */
+long PeakMemoryKB() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) return std::stol(line.substr(6));
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * Input: The scenario's config and the number of updates to run.
+ *
+ * Output: The scenario's measurements.
+ *
+ * Purpose: To time a run of a scenario in one mode, split into setting the
+ * world up, running its updates (including writing its data files), and
+ * writing the files written at the end of a run.
+ */
+template <typename WORLD_T, typename CONFIG_T, typename HOST_T, typename SYM_T>
+BenchResult RunScenario(CONFIG_T & config, size_t updates) {
+  using clock = std::chrono::steady_clock;
+  BenchResult result;
+  result.updates = updates;
+  ResetPeakMemory();
+
+  auto start = clock::now();
+  emp::Random random(config.SEED());
+  WORLD_T world(random, &config);
+  world.template UseModePolicy<HOST_T, SYM_T>();
+  world.Setup();
+  world.CreateDataFiles();
+  auto setup_done = clock::now();
+
+  for (size_t i = 0; i < updates; i++) {
+    result.organism_updates += world.GetNumHosts() + world.GetNumHostedSyms() + world.GetNumFreeSyms();
+    world.Update();
+  }
+  auto updates_done = clock::now();
+
+  if (config.PHYLOGENY() == 1) {
+    world.WritePhylogenyFile(config.FILE_PATH() + "Phylogeny_" + config.FILE_NAME() + "_SEED" + std::to_string(config.SEED()) + ".data");
+  }
+  auto finish_done = clock::now();
+
+  result.setup_seconds = std::chrono::duration<double>(setup_done - start).count();
+  result.update_seconds = std::chrono::duration<double>(updates_done - setup_done).count();
+  result.finish_seconds = std::chrono::duration<double>(finish_done - updates_done).count();
+  result.peak_rss_kb = PeakMemoryKB();
+  return result;
+}
+
+/**
+ * Input: The config to set up, the scenario, the grid width and height, the
+ * number of updates, and the folder for data files.
+ *
+ * Output: None
+ *
+ * Purpose: To build a scenario's config from the defaults and its settings.
+ */
+template <typename CONFIG_T>
+void SetupScenarioConfig(CONFIG_T & config, const BenchScenario & scenario, size_t grid_size, size_t updates, const std::string & data_path) {
+  config.SEED(2);
+  config.GRID_X(grid_size);
+  config.GRID_Y(grid_size);
+  config.UPDATES(updates);
+  config.FILE_PATH(data_path);
+  config.FILE_NAME("_" + scenario.name + "_" + std::to_string(grid_size));
+  for (const auto & [name, value] : scenario.settings) config.Set(name, value);
+}
+
+/**
+ * Input: The scenario, the grid width and height, the number of updates, and
+ * the folder for data files.
+ *
+ * Output: The scenario's measurements.
+ *
+ * Purpose: To run a scenario with the world and organisms of its mode.
+ */
+BenchResult RunBenchScenario(const BenchScenario & scenario, size_t grid_size, size_t updates, const std::string & data_path) {
+  if (scenario.mode == "lysis") {
+    SymConfigLysis config;
+    SetupScenarioConfig(config, scenario, grid_size, updates, data_path);
+    return RunScenario<LysisWorld, SymConfigLysis, Bacterium, Phage>(config, updates);
+  } else if (scenario.mode == "pgg") {
+    SymConfigPGG config;
+    SetupScenarioConfig(config, scenario, grid_size, updates, data_path);
+    return RunScenario<PGGWorld, SymConfigPGG, PGGHost, PGGSymbiont>(config, updates);
+  } else if (scenario.mode == "efficient") {
+    SymConfigEfficient config;
+    SetupScenarioConfig(config, scenario, grid_size, updates, data_path);
+    return RunScenario<EfficientWorld, SymConfigEfficient, EfficientHost, EfficientSymbiont>(config, updates);
+  }
+  SymConfigBase config;
+  SetupScenarioConfig(config, scenario, grid_size, updates, data_path);
+  return RunScenario<SymWorld, SymConfigBase, Host, Symbiont>(config, updates);
+}
+
+/**
+ * Input: The number of draws to time, and the kind of draw: uniform or normal.
+ *
+ * Output: The seconds emp::Random and a RandomPool take for the draws, in that order.
+ *
+ * Purpose: To compare the draw rate of the generator organisms use by
+ * default with that of the random number pools (RANDOM_POOL).
+ */
+std::pair<double, double> TimeRandomDraws(size_t draws, bool normal) {
+  using clock = std::chrono::steady_clock;
+  emp::Random random(2);
+  RandomPool pool;
+  pool.Reseed(random);
+  volatile double sink = 0; // keeps the draws from being optimized away
+
+  double sum = 0;
+  auto start = clock::now();
+  for (size_t i = 0; i < draws; i++) sum += normal ? random.GetNormal(0.0, 1.0) : random.GetDouble(0.0, 1.0);
+  auto emp_done = clock::now();
+  sink = sink + sum;
+
+  sum = 0;
+  for (size_t i = 0; i < draws; i++) sum += normal ? pool.GetNormal(0.0, 1.0) : pool.GetDouble(0.0, 1.0);
+  auto pool_done = clock::now();
+  sink = sink + sum;
+
+  return {std::chrono::duration<double>(emp_done - start).count(), std::chrono::duration<double>(pool_done - emp_done).count()};
+}
+
+/**
+ * Input: A comma-separated list.
+ *
+ * Output: The list's entries.
+ *
+ * Purpose: To read list arguments like "-sizes 32,64,128".
+ */
+emp::vector<std::string> SplitList(const std::string & list) {
+  emp::vector<std::string> entries;
+  std::stringstream in(list);
+  std::string entry;
+  while (std::getline(in, entry, ',')) {
+    if (entry != "") entries.push_back(entry);
+  }
+  return entries;
+}
+
+void PrintBenchUsage() {
+  std::cerr << "Usage: symbulation_bench [-sizes 32,64,128] [-updates 200] [-repeats 3] [-draws 10000000] [-scenarios name,...] [-label name] [-out bench_results.csv]" << std::endl;
+  std::cerr << "Scenarios: random_draws";
+  for (const BenchScenario & scenario : BENCH_SCENARIOS) std::cerr << " " << scenario.name;
+  std::cerr << std::endl;
+}
+
+// This is the main function for the benchmark suite.
+int main(int argc, char * argv[]) {
+  emp::vector<size_t> sizes = {32, 64, 128};
+  size_t updates = 200;
+  size_t repeats = 3;
+  size_t draws = 10000000;
+  emp::vector<std::string> scenario_names;
+  std::string label = "unlabeled";
+  std::string out_name = "bench_results.csv";
+  std::string data_path = "bench_data/";
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 == argc) {
+      PrintBenchUsage();
+      return 1;
+    }
+    std::string value = argv[++i];
+    if (arg == "-sizes") {
+      sizes.clear();
+      for (const std::string & size : SplitList(value)) sizes.push_back(std::stoul(size));
+    } else if (arg == "-updates") {
+      updates = std::stoul(value);
+    } else if (arg == "-repeats") {
+      repeats = std::max(std::stoul(value), 1ul);
+    } else if (arg == "-draws") {
+      draws = std::stoul(value);
+    } else if (arg == "-scenarios") {
+      scenario_names = SplitList(value);
+    } else if (arg == "-label") {
+      label = value;
+    } else if (arg == "-out") {
+      out_name = value;
+    } else {
+      PrintBenchUsage();
+      return 1;
+    }
+  }
+
+  emp::vector<BenchScenario> scenarios;
+  for (const BenchScenario & scenario : BENCH_SCENARIOS) {
+    if (scenario_names.size() == 0 || std::find(scenario_names.begin(), scenario_names.end(), scenario.name) != scenario_names.end()) {
+      scenarios.push_back(scenario);
+    }
+  }
+  bool time_draws = draws > 0 && (scenario_names.size() == 0 ||
+    std::find(scenario_names.begin(), scenario_names.end(), "random_draws") != scenario_names.end());
+  if ((scenarios.size() == 0 && !time_draws) || scenarios.size() + time_draws < scenario_names.size()) {
+    PrintBenchUsage();
+    return 1;
+  }
+
+  std::filesystem::create_directories(data_path);
+  bool new_file = !std::filesystem::exists(out_name);
+  std::ofstream out(out_name, std::ios::app);
+  if (new_file) {
+    out << "label,scenario,grid_size,updates,updates_per_sec,organism_updates_per_sec,peak_rss_kb,setup_sec,update_sec,finish_sec" << std::endl;
+  }
+
+  std::cout << std::left << std::setw(32) << "scenario" << std::setw(6) << "size"
+            << std::setw(12) << "updates/s" << std::setw(14) << "org-upd/s"
+            << std::setw(12) << "peak MB" << "setup/update/finish s" << std::endl;
+  if (time_draws) {
+    // recorded like scenarios, with draws in place of updates, so they can be compared the same way
+    for (bool normal : {false, true}) {
+      std::pair<double, double> seconds = TimeRandomDraws(draws, normal);
+      for (bool pooled : {false, true}) {
+        std::string name = std::string("rng_") + (normal ? "normal" : "uniform") + (pooled ? "_pool" : "_emp");
+        double time = pooled ? seconds.second : seconds.first;
+        out << label << "," << name << ",0," << draws << "," << draws / time << "," << draws / time << ",0,0," << time << ",0" << std::endl;
+        std::cout << std::setw(32) << name << std::setw(6) << "-" << std::setw(12) << "-"
+                  << std::fixed << std::setprecision(0) << std::setw(14) << draws / time << "(draws/s)" << std::endl;
+      }
+    }
+  }
+  for (const BenchScenario & scenario : scenarios) {
+    for (size_t size : sizes) {
+      // the fastest of several identical runs is the least disturbed by the rest of the machine
+      BenchResult result = RunBenchScenario(scenario, size, updates, data_path);
+      for (size_t repeat = 1; repeat < repeats; repeat++) {
+        BenchResult repeat_result = RunBenchScenario(scenario, size, updates, data_path);
+        if (repeat_result.update_seconds < result.update_seconds) result = repeat_result;
+      }
+      double updates_per_sec = result.updates / result.update_seconds;
+      double org_updates_per_sec = result.organism_updates / result.update_seconds;
+
+      out << label << "," << scenario.name << "," << size << "," << result.updates << ","
+          << updates_per_sec << "," << org_updates_per_sec << "," << result.peak_rss_kb << ","
+          << result.setup_seconds << "," << result.update_seconds << "," << result.finish_seconds << std::endl;
+      std::cout << std::setw(32) << scenario.name << std::setw(6) << size
+                << std::fixed << std::setprecision(1) << std::setw(12) << updates_per_sec
+                << std::setprecision(0) << std::setw(14) << org_updates_per_sec
+                << std::setprecision(1) << std::setw(12) << result.peak_rss_kb / 1024.0
+                << std::setprecision(3) << result.setup_seconds << "/" << result.update_seconds << "/" << result.finish_seconds << std::endl;
+    }
+  }
+  std::cout << "Results appended to " << out_name << std::endl;
+  return 0;
+}
@@ -3,22 +3,29 @@
 #include "../default_mode/DataNodes.h"
 #include "symbulation.h"
 
-// This is the main function for the NATIVE version of this project.
-int symbulation_main(int argc, char * argv[])
+/**
+ * Input: The settings for one run, and the stream to report its progress to.
+ *
+ * Output: None
+ *
+ * Purpose: To build a world from the settings, run the experiment, and write
+ * the files written at the end of a run.
+ */
+void RunSymbulation(SymConfigBase & config, std::ostream & log)
 {
-  SymConfigBase config;
-  CheckConfigFile(config, argc, argv);
-
-  config.Write(std::cout);
   emp::Random random(config.SEED());
 
   SymWorld world(random, &config);
 
+  world.UseModePolicy<Host, Symbiont>();
 
   world.Setup();
+  if (config.RESUME_CHECKPOINT()) {
+    world.LoadCheckpoint(world.GetCheckpointFileName());
+  }
   world.CreateDataFiles();
 
-  world.RunExperiment();
+  world.RunExperiment(true, log);
 
   //retrieve the dominant taxons for each organism and write them to a file
   std::string file_ending = "_SEED" + std::to_string(config.SEED()) + ".data";
@@ -31,6 +38,20 @@ int symbulation_main(int argc, char * argv[])
   if (config.WRITE_ORG_DUMP_FILE() == 1) {
     world.WriteOrgDumpFile(config.FILE_PATH() + "OrgDump" + config.FILE_NAME() + file_ending);
   }
+}
+
+// This is the main function for the NATIVE version of this project.
+int symbulation_main(int argc, char * argv[])
+{
+  SymConfigBase config;
+  CheckConfigFile(config, argc, argv);
+
+  if (config.BATCH_FILE() != "") {
+    return RunBatch<SymConfigBase>(config, RunSymbulation);
+  }
+
+  config.Write(std::cout);
+  RunSymbulation(config, std::cout);
   return 0;
 }
 
@@ -3,29 +3,50 @@
 #include "../default_mode/WorldSetup.cc"
 #include "symbulation.h"
 
-// This is the main function for the NATIVE version of this project.
-
-int symbulation_main(int argc, char * argv[])
+/**
+ * Input: The settings for one run, and the stream to report its progress to.
+ *
+ * Output: None
+ *
+ * Purpose: To build a world from the settings, run the experiment, and write
+ * the files written at the end of a run.
+ */
+void RunSymbulation(SymConfigEfficient & config, std::ostream & log)
 {
-  SymConfigEfficient config;
-  CheckConfigFile(config, argc, argv);
-
-  config.Write(std::cout);
   emp::Random random(config.SEED());
 
   EfficientWorld world(random, &config);
 
+  world.UseModePolicy<EfficientHost, EfficientSymbiont>();
+
   world.Setup();
+  if (config.RESUME_CHECKPOINT()) {
+    world.LoadCheckpoint(world.GetCheckpointFileName());
+  }
   world.CreateDataFiles();
 
-  world.RunExperiment();
+  world.RunExperiment(true, log);
 
   //retrieve the dominant taxons for each organism and write them to a file
   if(config.PHYLOGENY() == 1){
     std::string file_ending = "_SEED"+std::to_string(config.SEED())+".data";
     world.WritePhylogenyFile(config.FILE_PATH()+"Phylogeny_"+config.FILE_NAME()+file_ending);
   }
+}
+
+// This is the main function for the NATIVE version of this project.
+
+int symbulation_main(int argc, char * argv[])
+{
+  SymConfigEfficient config;
+  CheckConfigFile(config, argc, argv);
+
+  if (config.BATCH_FILE() != "") {
+    return RunBatch<SymConfigEfficient>(config, RunSymbulation);
+  }
 
+  config.Write(std::cout);
+  RunSymbulation(config, std::cout);
   return 0;
 }
 
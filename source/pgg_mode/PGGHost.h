@@ -5,7 +5,7 @@
 #include "PGGWorld.h"
 
 
-class PGGHost: public Host {
+class PGGHost final: public Host {
 protected:
 
   /**
@@ -119,7 +119,20 @@ public:
    * donations from them.
    */
   void DistribResources(double resources) {
-    Host::DistribResources(resources);
+    DistribResourcesAs<Organism, Organism>(resources);
+  }
+
+  /**
+   * Input: A double quantity of resources to be distributed.
+   *
+   * Output: None
+   *
+   * Purpose: The body of DistribResources(), with the host and symbiont types
+   * fixed at compile time as in Host::DistribResourcesAs().
+   */
+  template <typename HOST_T, typename SYM_T>
+  void DistribResourcesAs(double resources) {
+    Host::DistribResourcesAs<HOST_T, SYM_T>(resources);
 
     for(size_t i=0; i < syms.size(); i++){
       double host_pool = syms[i]->ProcessPool();
@@ -160,6 +173,30 @@ public:
     return host_baby;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the PGG host's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Host::WriteState(out);
+    out.Write(sourcepool);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Host::ReadState(in);
+    in.Read(sourcepool);
+  }
+
 };//PGGHost
 
 #endif
@@ -4,7 +4,7 @@
 #include "../default_mode/Symbiont.h"
 #include "PGGWorld.h"
 
-class PGGSymbiont: public Symbiont {
+class PGGSymbiont final: public Symbiont {
 protected:
 
   /**
@@ -126,6 +126,7 @@ public:
    * deviation that is equal to the mutation size.
    */
   void Mutate(){
+    OrgRandomPtr::PurposeScope mutation(KeyedRandom::MUTATION);
     Symbiont::Mutate();
     if (random->GetDouble(0.0, 1.0) <= pgg_config->MUTATION_RATE()) {
       PGG_donate += random->GetNormal(0.0, pgg_config->MUTATION_SIZE());
@@ -166,6 +167,30 @@ public:
     return sym_baby;
   }
 
+  /**
+   * Input: The checkpoint being written.
+   *
+   * Output: None
+   *
+   * Purpose: To save the PGG symbiont's state to a checkpoint.
+   */
+  void WriteState(CheckpointWriter & out) {
+    Symbiont::WriteState(out);
+    out.Write(PGG_donate);
+  }
+
+  /**
+   * Input: The checkpoint being read.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state WriteState() saved.
+   */
+  void ReadState(CheckpointReader & in) {
+    Symbiont::ReadState(in);
+    in.Read(PGG_donate);
+  }
+
   /**
    * Input: The PGG symbiont to be printed
    *
@@ -79,6 +79,7 @@ public:
   */
   void SetupHosts(long unsigned int* POP_SIZE);
   void SetupSymbionts(long unsigned int* total_syms);
+  emp::Ptr<Organism> NewCheckpointOrg(const std::string & name);
 
 
   /**
@@ -151,22 +152,22 @@ public:
   emp::DataMonitor<double, emp::data::Histogram>& GetPGGDataNode() {
     if (!data_node_PGG) {
       data_node_PGG.New();
-      OnUpdate([this](size_t){
+      size_t column = AddSymCensusColumn([](emp::Ptr<Organism> sym){ return sym->GetDonation(); });
+      AddDataNodeScan({&data_node_PGG}, [this, column](){
         data_node_PGG->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) { //track hosted syms
-            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-            size_t sym_size = syms.size();
-            for(size_t j=0; j< sym_size; j++){
-              data_node_PGG->AddDatum(syms[j]->GetDonation());
-            }//close for
-          }//close if
-          if(sym_pop[i]){ //track free-living syms
-            data_node_PGG->AddDatum(sym_pop[i]->GetDonation());
+        const PopulationStore & store = GetPopulationStore();
+        for (double donation : store.GetHostedSymColumn(column)) { //track hosted syms
+          data_node_PGG->AddDatum(donation);
+        }//close for
+        const emp::vector<double> & free_donations = store.GetFreeSymColumn(column);
+        for (size_t i : store.live_cells) {
+          if(store.free_sym_present[i]){ //track free-living syms
+            data_node_PGG->AddDatum(free_donations[i]);
           }//close if
         }//close for
       });
     }
+    RefreshDataNode(&data_node_PGG);
     data_node_PGG->SetupBins(0, 1.1, 11);
     return *data_node_PGG;
   }
@@ -61,4 +61,17 @@ void PGGWorld::SetupSymbionts(long unsigned int* total_syms) {
   }
 }
 
+/**
+ * Input: The type name an organism was saved under in a checkpoint.
+ *
+ * Output: A new organism of that type, to read the saved state into.
+ *
+ * Purpose: To recreate the PGG hosts and symbionts of a checkpoint.
+ */
+emp::Ptr<Organism> PGGWorld::NewCheckpointOrg(const std::string & name) {
+  if (name == "PGGHost") return emp::NewPtr<PGGHost>(&GetRandom(), this, pgg_config);
+  if (name == "PGGSymbiont") return emp::NewPtr<PGGSymbiont>(&GetRandom(), this, pgg_config);
+  return SymWorld::NewCheckpointOrg(name);
+}
+
 #endif
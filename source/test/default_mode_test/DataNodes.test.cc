@@ -1057,4 +1057,175 @@ TEST_CASE("GetVerticalTransmissionSuccessCount", "[default]") {
       host_baby.Delete();
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("GetPopulationStore", "[default]"){
+  GIVEN( "a world with hosts, hosted symbionts and a free-living symbiont" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.FREE_LIVING_SYMS(1);
+    config.SYM_LIMIT(3);
+    SymWorld world(random, &config);
+    world.Resize(4);
+
+    emp::Ptr<Host> host_0 = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+    emp::Ptr<Host> host_2 = emp::NewPtr<Host>(&random, &world, &config, -0.5);
+    host_0->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+    host_0->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.3));
+    host_2->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, -0.2));
+    world.AddOrgAt(host_0, 0);
+    world.AddOrgAt(host_2, 2);
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, 0.7), emp::WorldPosition(0, 3));
+
+    WHEN("the population store is requested"){
+      PopulationStore & store = world.GetPopulationStore();
+
+      THEN("it holds the population in columns"){
+        REQUIRE(store.GetNumCells() == 4);
+        REQUIRE(store.GetNumHosts() == 2);
+        REQUIRE(store.GetNumHostedSyms() == 3);
+        REQUIRE(store.GetNumFreeSyms() == 1);
+        REQUIRE(store.occupied[0]);
+        REQUIRE(!store.occupied[1]);
+        REQUIRE(store.host_int_val[2] == -0.5);
+        REQUIRE(store.GetSymCount(0) == 2);
+        REQUIRE(store.GetSymCount(1) == 0);
+        REQUIRE(store.sym_int_val[store.sym_start[0] + 1] == 0.3);
+        REQUIRE(store.sym_int_val[store.sym_start[2]] == -0.2);
+        REQUIRE(store.free_sym_present[3]);
+        REQUIRE(store.free_sym_int_val[3] == 0.7);
+      }
+    }
+
+    WHEN("a host dies and the world updates"){
+      world.GetPopulationStore();
+      world.DoDeath(0);
+      world.Update();
+
+      THEN("the store is refilled at the start of the update"){
+        PopulationStore & store = world.GetPopulationStore();
+        REQUIRE(!store.occupied[0]);
+        REQUIRE(store.GetNumHosts() == 1);
+        REQUIRE(store.GetNumHostedSyms() == 1);
+      }
+    }
+
+    WHEN("extra census columns are added"){
+      auto points = [](emp::Ptr<Organism> org){ return org->GetIntVal() * 10; };
+      size_t host_column = world.AddHostCensusColumn(points);
+      size_t sym_column = world.AddSymCensusColumn(points);
+      size_t hosted_only_column = world.AddSymCensusColumn(points, false);
+      PopulationStore & store = world.GetPopulationStore();
+
+      THEN("they are filled by the census walk"){
+        REQUIRE(store.GetHostColumn(host_column)[0] == 5);
+        REQUIRE(store.GetHostColumn(host_column)[2] == -5);
+        REQUIRE(store.GetHostedSymColumn(sym_column).size() == 3);
+        REQUIRE(store.GetHostedSymColumn(sym_column)[store.sym_start[0] + 1] == 3);
+        REQUIRE(store.GetFreeSymColumn(sym_column)[3] == 7);
+        REQUIRE(store.GetHostedSymColumn(hosted_only_column)[store.sym_start[2]] == -2);
+        REQUIRE(store.host_is_host[0]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Lazy data nodes", "[default]"){
+  GIVEN( "a world whose data nodes only update when data files sample them" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.DATA_INT(10);
+    SymWorld world(random, &config);
+    world.Resize(4);
+    world.SetLazyDataNodes(true);
+
+    emp::DataMonitor<int>& host_count_node = world.GetHostCountDataNode();
+    world.Update(); // update 0 is sampled
+    REQUIRE(host_count_node.GetTotal() == 0);
+
+    WHEN("hosts are added and the world updates without a sample"){
+      for(size_t i = 0; i < 3; i++){
+        world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), i);
+      }
+      world.Update(); // update 1 is not sampled
+
+      THEN("the data node is not rescanned during the update"){
+        REQUIRE(host_count_node.GetTotal() == 0);
+      }
+      THEN("asking for the data node brings it up to date"){
+        REQUIRE(world.GetHostCountDataNode().GetTotal() == 3);
+      }
+    }
+
+    WHEN("hosts are added and the world reaches a sampled update"){
+      for(size_t i = 0; i < 3; i++){
+        world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), i);
+      }
+      for(size_t i = 1; i <= 10; i++) world.Update();
+
+      THEN("the data node is rescanned for the sample"){
+        REQUIRE(host_count_node.GetTotal() == (double) world.GetNumOrgs());
+      }
+    }
+  }
+}
+
+TEST_CASE("Binary columnar data files", "[default]"){
+  GIVEN( "a world writing its host file in the binary columnar format" ) {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.BINARY_DATA_FILES(1);
+    SymWorld world(random, &config);
+
+    WHEN("the file is set up, written for two updates and closed"){
+      {
+        int update = 0;
+        emp::DataMonitor<double> hosts;
+        hosts.AddDatum(3);
+        ColumnarDataFile file("columnar_test.data", true);
+        file.AddVar(update, "update", "Update");
+        file.AddTotal(hosts, "count", "Total number of hosts");
+        file.PrintHeaderKeys();
+        file.Update();
+        update++;
+        file.Update();
+      }
+      std::ifstream in("columnar_test.data", std::ios::binary);
+      std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      std::remove("columnar_test.data");
+
+      THEN("it holds the schema followed by one chunk of typed columns"){
+        REQUIRE(contents.substr(0, 8) == "SYMCOL01");
+        uint32_t num_columns;
+        std::memcpy(&num_columns, contents.data() + 8, sizeof(num_columns));
+        REQUIRE(num_columns == 2);
+        REQUIRE(contents[12] == ColumnarDataFile::INT64);
+        REQUIRE(contents.substr(17, 6) == "update");
+
+        // the chunk is at the end: row count, then the update column at width 1
+        // (values 0 and 1), then the count column, which is constant
+        size_t chunk = contents.size() - (4 + 1 + 2 + 1 + 8);
+        uint32_t num_rows;
+        std::memcpy(&num_rows, contents.data() + chunk, sizeof(num_rows));
+        REQUIRE(num_rows == 2);
+        REQUIRE(contents[chunk + 4] == 1);
+        REQUIRE(contents[chunk + 5] == 0);
+        REQUIRE(contents[chunk + 6] == 1);
+        REQUIRE(contents[chunk + 7] == 0);
+        double count;
+        std::memcpy(&count, contents.data() + chunk + 8, sizeof(count));
+        REQUIRE(count == 3);
+      }
+    }
+
+    WHEN("the world sets up a data file"){
+      emp::DataFile & file = world.SetupHostIntValFile("columnar_world_test.data");
+
+      THEN("it is binary and named with the .cdata extension"){
+        REQUIRE(file.GetFilename() == "columnar_world_test.cdata");
+        REQUIRE(static_cast<ColumnarDataFile &>(file).IsBinary());
+      }
+    }
+    std::remove("columnar_world_test.cdata");
+  }
+}
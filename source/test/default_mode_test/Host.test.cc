@@ -533,7 +533,7 @@ TEST_CASE("AddSymbiont", "[default]"){
     emp::Ptr<Host> host = emp::NewPtr<Host>(random, &world, &config, int_val);
     emp::Ptr<Organism> symbiont = emp::NewPtr<Symbiont>(random, &world, &config, int_val);
     size_t pos = host->AddSymbiont(symbiont);
-    emp::vector<emp::Ptr<Organism>>& host_syms = host->GetSymbionts();
+    SymbiontList& host_syms = host->GetSymbionts();
     THEN("It is added to the host sym vector and it's position is returned"){
       REQUIRE(host->HasSym() == true);
       REQUIRE(pos == host_syms.size());
@@ -621,3 +621,87 @@ TEST_CASE("SymAllowedIn", "[default]") {
     }
   } 
 }
+
+TEST_CASE("Host symbiont storage", "[default]") {
+  GIVEN("a host in a world") {
+    emp::Random random(19);
+    SymConfigBase config;
+    config.HOST_REPRO_RES(10000);
+    SymWorld world(random, &config);
+    world.Resize(2, 2);
+    emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+    world.AddOrgAt(host, 0);
+
+    WHEN("the host holds a single symbiont") {
+      config.SYM_LIMIT(1);
+      host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+      THEN("it is stored inside the host's list") {
+        REQUIRE(host->GetSymbionts().size() == 1);
+        REQUIRE(host->GetSymbionts().capacity() == SymbiontList::INLINE_CAPACITY);
+      }
+    }
+
+    WHEN("the host holds more symbionts than fit inline") {
+      config.SYM_LIMIT(4);
+      host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+      host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+      THEN("room is made for SYM_LIMIT symbionts at once") {
+        REQUIRE(host->GetSymbionts().size() == 2);
+        REQUIRE(host->GetSymbionts().capacity() == 4);
+      }
+    }
+
+    WHEN("the first of three symbionts dies") {
+      config.SYM_LIMIT(3);
+      emp::vector<emp::Ptr<Organism>> syms;
+      for (size_t i = 0; i < 3; i++) {
+        syms.push_back(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+        host->AddSymbiont(syms[i]);
+      }
+      syms[0]->SetDead();
+
+      THEN("by default the last symbiont takes its place") {
+        config.KEEP_SYM_ORDER(0);
+        host->Process(0);
+        REQUIRE(host->GetSymbionts() == emp::vector<emp::Ptr<Organism>>{syms[2], syms[1]});
+        REQUIRE(world.GetNumHostedSyms() == 2);
+      }
+      THEN("with KEEP_SYM_ORDER the others keep their order") {
+        config.KEEP_SYM_ORDER(1);
+        host->Process(0);
+        REQUIRE(host->GetSymbionts() == emp::vector<emp::Ptr<Organism>>{syms[1], syms[2]});
+        REQUIRE(world.GetNumHostedSyms() == 2);
+      }
+    }
+  }
+}
+
+TEST_CASE("Organism pool recycling", "[default]") {
+  GIVEN("a world and a host") {
+    emp::Random random(17);
+    SymConfigBase config;
+    SymWorld world(random, &config);
+    OrganismPool & pool = OrganismPool::Get();
+
+    emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+    OrganismPool::Stats start_stats = pool.GetStats(sizeof(Host));
+
+    WHEN("the host dies and an offspring is made") {
+      Host * old_address = host.Raw();
+      host.Delete();
+      REQUIRE(pool.GetStats(sizeof(Host)).live == start_stats.live - 1);
+
+      emp::Ptr<Organism> offspring = emp::NewPtr<Host>(&random, &world, &config, 0.1);
+
+      THEN("the offspring is constructed in the recycled slot") {
+        OrganismPool::Stats stats = pool.GetStats(sizeof(Host));
+        REQUIRE(offspring.Raw() == old_address);
+        REQUIRE(stats.live == start_stats.live);
+        REQUIRE(stats.recycled == start_stats.recycled + 1);
+        REQUIRE(stats.peak >= stats.live);
+        REQUIRE(offspring->GetIntVal() == 0.1);
+      }
+      offspring.Delete();
+    }
+  }
+}
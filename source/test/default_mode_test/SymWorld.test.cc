@@ -1453,8 +1453,8 @@ TEST_CASE("Interaction Tracking Phylogeny", "[default]") {
     THEN("Symbiont-host interaction is tracked") {
       // Check that host and symbiont are not marked as interacting
       datastruct::HostTaxonData* data = static_cast<datastruct::HostTaxonData*>(&host->GetTaxon()->GetData());
-      REQUIRE(emp::Has(data->associated_syms, symbiont->GetTaxon()->GetID()));
-      REQUIRE(data->associated_syms[symbiont->GetTaxon()->GetID()] == 1);
+      REQUIRE(data->associated_syms.Has(symbiont->GetTaxon()->GetID()));
+      REQUIRE(data->associated_syms.Get(symbiont->GetTaxon()->GetID()) == 1);
     }
   }
   
@@ -1483,8 +1483,8 @@ TEST_CASE("Interaction Tracking Phylogeny", "[default]") {
     THEN("Symbiont-host interaction is tracked") {
       // Check that host and symbiont are marked as interacting
       datastruct::HostTaxonData* data = static_cast<datastruct::HostTaxonData*>(&child_host->GetTaxon()->GetData());
-      REQUIRE(emp::Has(data->associated_syms, child_symbiont->GetTaxon()->GetID()));
-      REQUIRE(data->associated_syms[child_symbiont->GetTaxon()->GetID()] == 1);
+      REQUIRE(data->associated_syms.Has(child_symbiont->GetTaxon()->GetID()));
+      REQUIRE(data->associated_syms.Get(child_symbiont->GetTaxon()->GetID()) == 1);
     }
 
 
@@ -1498,8 +1498,8 @@ TEST_CASE("Interaction Tracking Phylogeny", "[default]") {
     THEN("Symbiont-host interactions are counted") {
       // Check that host and symbiont are marked as interacting
       datastruct::HostTaxonData* data = static_cast<datastruct::HostTaxonData*>(&grandchild_host->GetTaxon()->GetData());
-      REQUIRE(emp::Has(data->associated_syms, grandchild_symbiont->GetTaxon()->GetID()));
-      REQUIRE(data->associated_syms[grandchild_symbiont->GetTaxon()->GetID()] == 2);
+      REQUIRE(data->associated_syms.Has(grandchild_symbiont->GetTaxon()->GetID()));
+      REQUIRE(data->associated_syms.Get(grandchild_symbiont->GetTaxon()->GetID()) == 2);
     }
     parent_symbiont.Delete();
   }
@@ -1856,10 +1856,17 @@ TEST_CASE("Tag matching", "[default]") {
     int starting_res = 15;
     config.SYM_HORIZ_TRANS_RES(trans_res);
     config.SYM_VERT_TRANS_RES(trans_res);
-    double tag_distance_limit = 0.125;
+    config.VERTICAL_TRANSMISSION(1);
     config.TAG_MATCHING(1);
-    config.TAG_DISTANCE(tag_distance_limit);
     config.TAG_MUTATION_SIZE(0.0);
+    // host tags with TAG_LENGTH/8 ones are this far from the all-0 symbiont tag
+    double close_distance = 0.125;
+    // cutoffs are drawn with a mean of TAG_DISTANCE * TAG_LENGTH bits, so with
+    // a mean of 1000 bits a cutoff is never, to double precision, as small as
+    // the close distance, and with a mean of 0 every cutoff is 0; either way
+    // tag matching doesn't depend on the seed
+    double certain_match = 1000.0 / TAG_LENGTH;
+    double certain_mismatch = 0.0;
     double int_val = 0;
 
     SymWorld world(random, &config);
@@ -1877,7 +1884,8 @@ TEST_CASE("Tag matching", "[default]") {
         // host tag has 4 1s
         emp::BitSet<TAG_LENGTH> bit_set_1 = emp::BitSet<TAG_LENGTH>(TAG_LENGTH, random, TAG_LENGTH/8);
         host->SetTag(bit_set_1);
-        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) <= tag_distance_limit);
+        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) == close_distance);
+        config.TAG_DISTANCE(certain_match);
 
         symbiont->VerticalTransmission(host);
 
@@ -1888,6 +1896,7 @@ TEST_CASE("Tag matching", "[default]") {
           REQUIRE(symbiont->GetPoints() == starting_res-trans_res);
         }
         THEN("The child symbiont starts with 0 points") {
+          REQUIRE(host->HasSym());
           REQUIRE(host->GetSymbionts().at(0)->GetPoints() == 0);
         }
       }
@@ -1895,7 +1904,8 @@ TEST_CASE("Tag matching", "[default]") {
         // host tag has 9 1s
         emp::BitSet<TAG_LENGTH> bit_set_1 = emp::BitSet<TAG_LENGTH>(TAG_LENGTH, random, (TAG_LENGTH/4)+1);
         host->SetTag(bit_set_1);
-        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) > tag_distance_limit);
+        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) > close_distance);
+        config.TAG_DISTANCE(certain_mismatch);
 
         symbiont->VerticalTransmission(host);
 
@@ -1912,8 +1922,8 @@ TEST_CASE("Tag matching", "[default]") {
     }
     
     WHEN("A symbiont tries to horizontally transmit offspring into a host") {
-      // note that these can fail simply because the empty 
-      // neighbor host is not selected by getrandomneighbor
+      // the neighbor picked can be the source host itself, which has no
+      // room; that fails the same way as a tag mismatch or a full target
 
       emp::Ptr<Host> source_host = emp::NewPtr<Host>(&random, &world, &config, int_val);
       emp::Ptr<Host> target_host = emp::NewPtr<Host>(&random, &world, &config, int_val);
@@ -1938,9 +1948,14 @@ TEST_CASE("Tag matching", "[default]") {
         // host tag has 4 1s
         emp::BitSet<TAG_LENGTH> bit_set_1 = emp::BitSet<TAG_LENGTH>(TAG_LENGTH, random, TAG_LENGTH/8);
         target_host->SetTag(bit_set_1);
-        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) == tag_distance_limit);
+        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) == close_distance);
+        config.TAG_DISTANCE(certain_match);
 
-        symbiont->HorizontalTransmission(emp::WorldPosition(1, source_pos));
+        // the source host can be picked as its own neighbor, which fails for
+        // lack of room without spending points, so try until the target is picked
+        for (int attempt = 0; attempt < 100 && !target_host->HasSym(); attempt++) {
+          symbiont->HorizontalTransmission(emp::WorldPosition(1, source_pos));
+        }
         
         THEN("The symbiont succeeds") {
           REQUIRE(target_host->HasSym() == true);
@@ -1950,6 +1965,7 @@ TEST_CASE("Tag matching", "[default]") {
           REQUIRE(symbiont->GetPoints() == 0);
         }
         THEN("The child symbiont starts with 0 points"){
+          REQUIRE(target_host->HasSym());
           REQUIRE(target_host->GetSymbionts().at(0)->GetPoints() == 0);
         }
       }
@@ -1972,7 +1988,8 @@ TEST_CASE("Tag matching", "[default]") {
         // host tag has 4 1s
         emp::BitSet<TAG_LENGTH> bit_set_1 = emp::BitSet<TAG_LENGTH>(TAG_LENGTH, random, TAG_LENGTH/8);
         target_host->SetTag(bit_set_1);
-        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) == tag_distance_limit);
+        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) == close_distance);
+        config.TAG_DISTANCE(certain_match);
 
         symbiont->HorizontalTransmission(emp::WorldPosition(1, source_pos));
 
@@ -2000,7 +2017,8 @@ TEST_CASE("Tag matching", "[default]") {
         // host tag has 9 1s
         emp::BitSet<TAG_LENGTH> bit_set_1 = emp::BitSet<TAG_LENGTH>(TAG_LENGTH, random, (TAG_LENGTH/4)+1);
         target_host->SetTag(bit_set_1);
-        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) > tag_distance_limit);
+        REQUIRE(world.GetTagMetric()->calculate(bit_set_0, bit_set_1) > close_distance);
+        config.TAG_DISTANCE(certain_mismatch);
 
         symbiont->HorizontalTransmission(emp::WorldPosition(1, source_pos));
 
@@ -2033,3 +2051,1142 @@ TEST_CASE("SendToGraveyard", "[default]") {
   }
 
 }
+
+TEST_CASE("Tiled parallel update", "[default]") {
+  GIVEN("two identically seeded grid worlds processed by different numbers of threads") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(32);
+    config.GRID_Y(32);
+    config.POP_SIZE(200);
+    config.SYM_LIMIT(3);
+    config.HOST_REPRO_RES(200);
+    config.SYM_HORIZ_TRANS_RES(20);
+    config.TILE_SIZE(4);
+
+    emp::Random random_a(23);
+    config.UPDATE_THREADS(2);
+    SymWorld world_a(random_a, &config);
+    world_a.Setup();
+
+    emp::Random random_b(23);
+    config.UPDATE_THREADS(4);
+    SymWorld world_b(random_b, &config);
+    world_b.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 20; i++) {
+        world_a.Update();
+        world_b.Update();
+      }
+      THEN("the results do not depend on the thread count") {
+        REQUIRE(world_a.GetNumOrgs() == world_b.GetNumOrgs());
+        for (size_t i = 0; i < world_a.GetSize(); i++) {
+          REQUIRE(world_a.IsOccupied(i) == world_b.IsOccupied(i));
+          if (world_a.IsOccupied(i)) {
+            REQUIRE(world_a.GetOrg(i).GetIntVal() == world_b.GetOrg(i).GetIntVal());
+            REQUIRE(world_a.GetOrg(i).GetSymbionts().size() == world_b.GetOrg(i).GetSymbionts().size());
+          }
+        }
+      }
+    }
+  }
+
+  GIVEN("two identically seeded grid worlds with limited resources processed by different numbers of threads") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(32);
+    config.GRID_Y(32);
+    config.POP_SIZE(200);
+    config.SYM_LIMIT(3);
+    config.HOST_REPRO_RES(200);
+    config.SYM_HORIZ_TRANS_RES(20);
+    config.TILE_SIZE(4);
+    config.LIMITED_RES_TOTAL(3000);
+    config.LIMITED_RES_INFLOW(1000);
+
+    emp::Random random_a(31);
+    config.UPDATE_THREADS(2);
+    SymWorld world_a(random_a, &config);
+    world_a.Setup();
+
+    emp::Random random_b(31);
+    config.UPDATE_THREADS(4);
+    SymWorld world_b(random_b, &config);
+    world_b.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 20; i++) {
+        world_a.Update();
+        world_b.Update();
+      }
+      THEN("the resources handed out do not depend on the thread count") {
+        REQUIRE(world_a.PullResources(1000000) == world_b.PullResources(1000000));
+        REQUIRE(world_a.GetNumOrgs() == world_b.GetNumOrgs());
+        for (size_t i = 0; i < world_a.GetSize(); i++) {
+          REQUIRE(world_a.IsOccupied(i) == world_b.IsOccupied(i));
+          if (world_a.IsOccupied(i)) {
+            REQUIRE(world_a.GetOrg(i).GetPoints() == world_b.GetOrg(i).GetPoints());
+            REQUIRE(world_a.GetOrg(i).GetSymbionts().size() == world_b.GetOrg(i).GetSymbionts().size());
+          }
+        }
+      }
+    }
+  }
+
+  GIVEN("a grid world with limited resources processed in tiles") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(32);
+    config.GRID_Y(32);
+    config.POP_SIZE(256);
+    config.TILE_SIZE(4);
+    config.UPDATE_THREADS(4);
+    config.LIMITED_RES_TOTAL(25000);
+    config.LIMITED_RES_INFLOW(15000);
+
+    emp::Random random(7);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    WHEN("the world is updated for a while") {
+      for (size_t i = 0; i < 150; i++) world.Update();
+
+      THEN("no checkerboard phase of tiles gets more hosts or points than the others") {
+        // 32 cells split into 8 tiles a side, so tiles are 4 cells wide and
+        // a cell's phase follows from its tile's column and row
+        emp::vector<double> hosts(4, 0), points(4, 0);
+        for (size_t i = 0; i < world.GetSize(); i++) {
+          if (!world.IsOccupied(i)) continue;
+          const size_t phase = (i % 32) / 4 % 2 + 2 * ((i / 32) / 4 % 2);
+          hosts[phase]++;
+          points[phase] += world.GetOrg(i).GetPoints();
+        }
+        const double mean_hosts = (hosts[0] + hosts[1] + hosts[2] + hosts[3]) / 4;
+        const double mean_points = (points[0] + points[1] + points[2] + points[3]) / (4 * mean_hosts);
+        REQUIRE(mean_hosts > 0);
+        for (size_t phase = 0; phase < 4; phase++) {
+          REQUIRE(hosts[phase] == Approx(mean_hosts).epsilon(0.25));
+          REQUIRE(points[phase] / hosts[phase] == Approx(mean_points).epsilon(0.25));
+        }
+      }
+    }
+  }
+
+  GIVEN("a grid world too small to be split into tiles") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(6);
+    config.GRID_Y(6);
+    config.UPDATE_THREADS(4);
+    config.TILE_SIZE(4);
+
+    emp::Random random(29);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    WHEN("the world is updated") {
+      world.Update();
+      THEN("it falls back to the serial update") {
+        REQUIRE(world.GetNumOrgs() > 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("Random number pools", "[default]") {
+  GIVEN("two pools seeded from identically seeded generators") {
+    emp::Random random_a(47);
+    emp::Random random_b(47);
+    RandomPool pool_a;
+    RandomPool pool_b;
+    pool_a.Reseed(random_a);
+    pool_b.Reseed(random_b);
+
+    WHEN("uniforms and normals are drawn in different interleavings") {
+      emp::vector<double> uniforms_a, uniforms_b, normals_a, normals_b;
+      for (size_t i = 0; i < 1000; i++) {
+        uniforms_a.push_back(pool_a.GetDouble());
+        normals_a.push_back(pool_a.GetNormal());
+      }
+      for (size_t i = 0; i < 1000; i++) uniforms_b.push_back(pool_b.GetDouble());
+      for (size_t i = 0; i < 1000; i++) normals_b.push_back(pool_b.GetNormal());
+
+      THEN("each stream is the same") {
+        REQUIRE(uniforms_a == uniforms_b);
+        REQUIRE(normals_a == normals_b);
+      }
+      THEN("the draws are distributed as expected") {
+        double uniform_mean = 0, normal_mean = 0, normal_var = 0;
+        for (size_t i = 0; i < 1000; i++) {
+          REQUIRE(uniforms_a[i] >= 0);
+          REQUIRE(uniforms_a[i] < 1);
+          uniform_mean += uniforms_a[i] / 1000;
+          normal_mean += normals_a[i] / 1000;
+          normal_var += normals_a[i] * normals_a[i] / 1000;
+        }
+        REQUIRE(uniform_mean == Approx(0.5).margin(0.05));
+        REQUIRE(normal_mean == Approx(0).margin(0.1));
+        REQUIRE(normal_var == Approx(1).margin(0.15));
+      }
+    }
+  }
+
+  GIVEN("two identically seeded grid worlds drawing from pools with different numbers of threads") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(32);
+    config.GRID_Y(32);
+    config.POP_SIZE(200);
+    config.SYM_LIMIT(3);
+    config.HOST_REPRO_RES(200);
+    config.TILE_SIZE(4);
+    config.RANDOM_POOL(1);
+
+    emp::Random random_a(53);
+    config.UPDATE_THREADS(2);
+    SymWorld world_a(random_a, &config);
+    world_a.Setup();
+
+    emp::Random random_b(53);
+    config.UPDATE_THREADS(4);
+    SymWorld world_b(random_b, &config);
+    world_b.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 20; i++) {
+        world_a.Update();
+        world_b.Update();
+      }
+      THEN("the results do not depend on the thread count") {
+        REQUIRE(world_a.GetNumOrgs() == world_b.GetNumOrgs());
+        for (size_t i = 0; i < world_a.GetSize(); i++) {
+          REQUIRE(world_a.IsOccupied(i) == world_b.IsOccupied(i));
+          if (world_a.IsOccupied(i)) REQUIRE(world_a.GetOrg(i).GetIntVal() == world_b.GetOrg(i).GetIntVal());
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Keyed random numbers", "[default]") {
+  GIVEN("the Philox4x32-10 generator") {
+    THEN("it matches the published known-answer vectors") {
+      REQUIRE(KeyedRandom::Philox({0, 0, 0, 0}, {0, 0}) == KeyedRandom::block_t{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+      REQUIRE(KeyedRandom::Philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0})
+              == KeyedRandom::block_t{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+    }
+  }
+
+  GIVEN("two keyed generators with the same seed") {
+    KeyedRandom keyed_a;
+    KeyedRandom keyed_b;
+    keyed_a.SetSeed(61);
+    keyed_b.SetSeed(61);
+
+    WHEN("one draws for other cells, slots and purposes before reaching a cell") {
+      keyed_a.StartCell(5, 3);
+      double host_draw_a = keyed_a.GetDouble();
+      keyed_a.SetAddress(0, KeyedRandom::MUTATION);
+      double mutation_draw_a = keyed_a.GetDouble();
+
+      keyed_b.StartCell(5, 1);
+      for (size_t i = 0; i < 10; i++) keyed_b.GetDouble();
+      keyed_b.StartCell(5, 3);
+      keyed_b.SetAddress(0, KeyedRandom::MUTATION);
+      double mutation_draw_b = keyed_b.GetDouble();
+      keyed_b.SetAddress(1, KeyedRandom::GENERAL);
+      keyed_b.GetDouble();
+      keyed_b.SetAddress(0, KeyedRandom::GENERAL);
+      double host_draw_b = keyed_b.GetDouble();
+
+      THEN("the cell's draws depend only on their address") {
+        REQUIRE(host_draw_a == host_draw_b);
+        REQUIRE(mutation_draw_a == mutation_draw_b);
+        REQUIRE(host_draw_a != mutation_draw_a);
+      }
+      THEN("they can be replayed from the address alone") {
+        KeyedRandom::block_t block = KeyedRandom::Draw(61, 5, 3, 0, KeyedRandom::GENERAL, 0);
+        REQUIRE(host_draw_a == ((((uint64_t) block[0]) << 21) ^ (block[1] >> 11)) * 0x1.0p-53);
+      }
+    }
+
+    WHEN("both draw Poisson numbers with a mean too large for exp(-mean)") {
+      keyed_a.StartCell(7, 2);
+      keyed_b.StartCell(7, 2);
+      const double mean = 2000;
+      const size_t num_draws = 4000;
+      double sum = 0;
+      bool same = true;
+      for (size_t i = 0; i < num_draws; i++) {
+        const uint32_t draw = keyed_a.GetPoisson(mean);
+        same = same && draw == keyed_b.GetPoisson(mean);
+        sum += draw;
+      }
+      THEN("the draws match and average close to the mean") {
+        REQUIRE(same);
+        REQUIRE(sum / num_draws > mean - 5);
+        REQUIRE(sum / num_draws < mean + 5);
+      }
+    }
+  }
+
+  GIVEN("two identically seeded grid worlds drawing keyed numbers with different numbers of threads") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(32);
+    config.GRID_Y(32);
+    config.POP_SIZE(200);
+    config.SYM_LIMIT(3);
+    config.HOST_REPRO_RES(200);
+    config.TILE_SIZE(4);
+    config.KEYED_RANDOM(1);
+
+    emp::Random random_a(59);
+    config.UPDATE_THREADS(2);
+    SymWorld world_a(random_a, &config);
+    world_a.Setup();
+
+    emp::Random random_b(59);
+    config.UPDATE_THREADS(4);
+    SymWorld world_b(random_b, &config);
+    world_b.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 20; i++) {
+        world_a.Update();
+        world_b.Update();
+      }
+      THEN("the results do not depend on the thread count") {
+        REQUIRE(world_a.GetNumOrgs() == world_b.GetNumOrgs());
+        for (size_t i = 0; i < world_a.GetSize(); i++) {
+          REQUIRE(world_a.IsOccupied(i) == world_b.IsOccupied(i));
+          if (world_a.IsOccupied(i)) REQUIRE(world_a.GetOrg(i).GetIntVal() == world_b.GetOrg(i).GetIntVal());
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Update schedulers", "[default]") {
+  GIVEN("a world with a few occupied cells") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(10);
+    config.GRID_Y(7);
+    config.POP_SIZE(0);
+
+    emp::Random random(37);
+    SymWorld world(random, &config);
+    world.Setup();
+    for (size_t i : {3, 17, 40}) world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config), i);
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config), emp::WorldPosition(0, 52));
+
+    WHEN("the default scheduler orders the cells") {
+      PermutationScheduler scheduler;
+      emp::Random expected_random(41);
+      emp::vector<size_t> expected = emp::GetPermutation(expected_random, world.GetSize());
+      emp::Random scheduler_random(41);
+      emp::vector<size_t> order = scheduler.Schedule(scheduler_random, world.GetPop(), world.GetSymPop());
+      THEN("it matches emp::GetPermutation() for the same seed") {
+        REQUIRE(order == expected);
+      }
+    }
+
+    WHEN("the blocked scheduler orders the cells") {
+      BlockedScheduler scheduler(7);
+      emp::vector<size_t> order = scheduler.Schedule(random, world.GetPop(), world.GetSymPop());
+      THEN("every cell appears once, with each block's cells together") {
+        REQUIRE(order.size() == world.GetSize());
+        emp::vector<size_t> sorted = order;
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); i++) REQUIRE(sorted[i] == i);
+        for (size_t i = 0; i < order.size(); i++) {
+          REQUIRE(order[i] / 7 == order[i - i % 7] / 7);
+        }
+      }
+    }
+
+    WHEN("the occupied-cell scheduler orders the cells") {
+      OccupiedScheduler scheduler;
+      emp::vector<size_t> order = scheduler.Schedule(random, world.GetPop(), world.GetSymPop());
+      THEN("only the cells holding a host or a free-living symbiont appear") {
+        std::sort(order.begin(), order.end());
+        REQUIRE(order == emp::vector<size_t>{3, 17, 40, 52});
+      }
+    }
+
+    WHEN("the occupied-cell scheduler takes the cells from the world's occupancy index") {
+      OccupiedScheduler scanning_scheduler;
+      OccupiedScheduler indexed_scheduler(&world.GetOccupancy());
+      emp::Random scanning_random(47);
+      emp::Random indexed_random(47);
+      emp::vector<size_t> scanned = scanning_scheduler.Schedule(scanning_random, world.GetPop(), world.GetSymPop());
+      emp::vector<size_t> indexed = indexed_scheduler.Schedule(indexed_random, world.GetPop(), world.GetSymPop());
+      THEN("it draws the same order as scanning every cell") {
+        REQUIRE(indexed == scanned);
+      }
+    }
+  }
+
+  GIVEN("worlds processed with each scheduler") {
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(20);
+    config.GRID_Y(20);
+    config.POP_SIZE(100);
+    config.HOST_REPRO_RES(200);
+    config.SCHEDULE_BLOCK_SIZE(16);
+
+    for (int scheduler : {0, 1, 2}) {
+      config.SCHEDULER(scheduler);
+      emp::Random random(43);
+      SymWorld world(random, &config);
+      world.Setup();
+
+      WHEN("the world is updated") {
+        for (size_t i = 0; i < 20; i++) world.Update();
+        THEN("hosts are processed and reproduce") {
+          REQUIRE(world.GetNumOrgs() > 100);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("UseModePolicy", "[default]") {
+  GIVEN("two identically seeded worlds, one with its organism types fixed at compile time") {
+    SymConfigBase config;
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.HOST_REPRO_RES(300);
+
+    emp::Random random_virtual(31);
+    SymWorld world_virtual(random_virtual, &config);
+    world_virtual.Setup();
+
+    emp::Random random_policy(31);
+    SymWorld world_policy(random_policy, &config);
+    world_policy.UseModePolicy<Host, Symbiont>();
+    world_policy.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 10; i++) {
+        world_virtual.Update();
+        world_policy.Update();
+      }
+      THEN("they produce the same population") {
+        REQUIRE(world_virtual.GetNumOrgs() == world_policy.GetNumOrgs());
+        for (size_t i = 0; i < world_virtual.GetSize(); i++) {
+          REQUIRE(world_virtual.IsOccupied(i) == world_policy.IsOccupied(i));
+          if (world_virtual.IsOccupied(i)) {
+            REQUIRE(world_virtual.GetOrg(i).GetIntVal() == world_policy.GetOrg(i).GetIntVal());
+            REQUIRE(world_virtual.GetOrg(i).GetPoints() == world_policy.GetOrg(i).GetPoints());
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Feature-specialized process kernels", "[default]") {
+  GIVEN("two identically seeded worlds with free-living symbionts and ectosymbiosis") {
+    SymConfigBase config;
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.FREE_LIVING_SYMS(1);
+    config.ECTOSYMBIOSIS(1);
+    config.MOVE_FREE_SYMS(1);
+    config.FREE_SYM_RES_DISTRIBUTE(50);
+    config.SYM_HORIZ_TRANS_RES(40);
+    config.START_MOI(2);
+
+    emp::Random random_virtual(37);
+    SymWorld world_virtual(random_virtual, &config);
+    world_virtual.Setup();
+
+    emp::Random random_kernel(37);
+    SymWorld world_kernel(random_kernel, &config);
+    world_kernel.UseModePolicy<Host, Symbiont>();
+    world_kernel.Setup();
+
+    WHEN("both worlds are updated") {
+      for (size_t i = 0; i < 10; i++) {
+        world_virtual.Update();
+        world_kernel.Update();
+      }
+      THEN("the specialized kernels match the virtual path") {
+        REQUIRE(world_virtual.GetNumOrgs() == world_kernel.GetNumOrgs());
+        for (size_t i = 0; i < world_virtual.GetSize(); i++) {
+          REQUIRE((bool) world_virtual.GetSymAt(i) == (bool) world_kernel.GetSymAt(i));
+          if (world_virtual.GetSymAt(i)) {
+            REQUIRE(world_virtual.GetSymAt(i)->GetPoints() == world_kernel.GetSymAt(i)->GetPoints());
+          }
+          if (world_virtual.IsOccupied(i)) {
+            REQUIRE(world_virtual.GetOrg(i).GetPoints() == world_kernel.GetOrg(i).GetPoints());
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Incremental population counts", "[default]") {
+  GIVEN("a world with a host and a free-living symbiont") {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.FREE_LIVING_SYMS(1);
+    config.SYM_LIMIT(2);
+    SymWorld world(random, &config);
+    world.Resize(4);
+
+    emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+    host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.1));
+    world.AddOrgAt(host, 0);
+    world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0.5), 1);
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, 0.2), emp::WorldPosition(0, 2));
+
+    THEN("placing them counts them and the symbionts they carry") {
+      REQUIRE(world.GetNumHosts() == 2);
+      REQUIRE(world.GetNumHostedSyms() == 1);
+      REQUIRE(world.GetNumUninfectedHosts() == 1);
+      REQUIRE(world.GetNumFreeSyms() == 1);
+      REQUIRE(world.CheckPopulationCounts());
+    }
+
+    WHEN("the free-living symbiont infects the uninfected host") {
+      world.GetOrg(1).AddSymbiont(world.ExtractSym(2));
+
+      THEN("the counts move it from free-living to hosted") {
+        REQUIRE(world.GetNumFreeSyms() == 0);
+        REQUIRE(world.GetNumHostedSyms() == 2);
+        REQUIRE(world.GetNumUninfectedHosts() == 0);
+        REQUIRE(world.CheckPopulationCounts());
+      }
+    }
+
+    WHEN("the infected host dies") {
+      world.DoDeath(0);
+
+      THEN("its symbionts leave the counts with it") {
+        REQUIRE(world.GetNumHosts() == 1);
+        REQUIRE(world.GetNumHostedSyms() == 0);
+        REQUIRE(world.GetNumUninfectedHosts() == 1);
+        REQUIRE(world.CheckPopulationCounts());
+      }
+    }
+
+    WHEN("the infected host loses its symbionts") {
+      emp::Ptr<Organism> sym = host->GetSymbionts()[0];
+      host->ClearSyms();
+      sym.Delete();
+
+      THEN("it is counted as uninfected") {
+        REQUIRE(world.GetNumHostedSyms() == 0);
+        REQUIRE(world.GetNumUninfectedHosts() == 2);
+      }
+    }
+  }
+}
+
+TEST_CASE("Occupancy index", "[default]") {
+  GIVEN("an occupancy index") {
+    OccupancyIndex occupancy;
+    occupancy.Resize(10);
+    occupancy.Set(7, OccupancyIndex::HOST, true);
+    occupancy.Set(2, OccupancyIndex::FREE_SYM, true);
+    occupancy.Set(5, OccupancyIndex::HOST, true);
+    occupancy.Set(5, OccupancyIndex::FREE_SYM, true);
+
+    WHEN("organisms leave some cells") {
+      occupancy.Set(7, OccupancyIndex::HOST, false);
+      occupancy.Set(5, OccupancyIndex::HOST, false);
+
+      THEN("a cell stays live while any organism remains in it") {
+        REQUIRE(occupancy.GetNumLive() == 2);
+        REQUIRE(occupancy.IsLive(2));
+        REQUIRE(occupancy.IsLive(5));
+        REQUIRE(!occupancy.IsLive(7));
+        REQUIRE(occupancy.GetSortedCells() == emp::vector<size_t>{2, 5});
+      }
+    }
+
+    WHEN("the sorted cells are read before and after a cell comes to life") {
+      emp::vector<size_t> before = occupancy.GetSortedCells();
+      occupancy.Set(0, OccupancyIndex::HOST, true);
+
+      THEN("the sorted cells are brought up to date") {
+        REQUIRE(before == emp::vector<size_t>{2, 5, 7});
+        REQUIRE(occupancy.GetSortedCells() == emp::vector<size_t>{0, 2, 5, 7});
+      }
+    }
+  }
+
+  GIVEN("a sparse world with free-living symbionts") {
+    emp::Random random(71);
+    SymConfigBase config;
+    config.GRID(1);
+    config.GRID_X(30);
+    config.GRID_Y(30);
+    config.POP_SIZE(40);
+    config.FREE_LIVING_SYMS(1);
+    config.MOVE_FREE_SYMS(1);
+    config.HOST_AGE_MAX(10);
+    config.SYM_AGE_MAX(10);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    WHEN("organisms are born, move, infect hosts and die") {
+      for (size_t i = 0; i < 30; i++) world.Update();
+
+      THEN("the occupancy index tracks exactly the live cells") {
+        REQUIRE(world.CheckPopulationCounts());
+        REQUIRE(world.GetOccupancy().GetNumLive() < world.GetSize());
+      }
+      THEN("gathering only the live cells fills the store like a full scan") {
+        PopulationStore full;
+        PopulationStore sparse;
+        full.Gather(world.GetPop(), world.GetSymPop());
+        sparse.Gather(world.GetPop(), world.GetSymPop(), world.GetOccupancy().GetSortedCells());
+        REQUIRE(sparse.live_cells == full.live_cells);
+        REQUIRE(sparse.occupied == full.occupied);
+        REQUIRE(sparse.free_sym_present == full.free_sym_present);
+        REQUIRE(sparse.sym_int_val == full.sym_int_val);
+        for (size_t i : full.live_cells) {
+          REQUIRE(sparse.GetSymCount(i) == full.GetSymCount(i));
+          if (full.occupied[i]) REQUIRE(sparse.host_int_val[i] == full.host_int_val[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Checkpoint and resume", "[default]") {
+  GIVEN("a world that has run for a while and written a checkpoint") {
+    emp::Random random(21);
+    SymConfigBase config;
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.FREE_LIVING_SYMS(1);
+    config.TAG_MATCHING(0);
+    config.SYM_LIMIT(2);
+    SymWorld world(random, &config);
+    world.Setup();
+    for (int i = 0; i < 20; i++) world.Update();
+    world.WriteCheckpoint("checkpoint_test.chk");
+
+    WHEN("another world with the same settings is restored from the checkpoint") {
+      emp::Random resumed_random(5);
+      SymWorld resumed(resumed_random, &config);
+      resumed.Setup();
+      resumed.LoadCheckpoint("checkpoint_test.chk");
+
+      THEN("it starts out identical to the original world") {
+        REQUIRE(resumed.GetUpdate() == world.GetUpdate());
+        REQUIRE(resumed.GetNumOrgs() == world.GetNumOrgs());
+        REQUIRE(resumed.GetNumHostedSyms() == world.GetNumHostedSyms());
+        REQUIRE(resumed.GetNumFreeSyms() == world.GetNumFreeSyms());
+      }
+
+      THEN("both worlds stay identical as they keep running") {
+        for (int i = 0; i < 20; i++) {
+          world.Update();
+          resumed.Update();
+        }
+        REQUIRE(resumed.GetUpdate() == world.GetUpdate());
+        REQUIRE(resumed.GetNumOrgs() == world.GetNumOrgs());
+        REQUIRE(resumed.GetNumHostedSyms() == world.GetNumHostedSyms());
+
+        bool same = true;
+        for (size_t i = 0; i < world.GetSize(); i++) {
+          emp::Ptr<Organism> host = world.GetPop()[i];
+          emp::Ptr<Organism> resumed_host = resumed.GetPop()[i];
+          if (!host || !resumed_host) {
+            same = same && !host && !resumed_host;
+            continue;
+          }
+          same = same && host->GetIntVal() == resumed_host->GetIntVal() && host->GetPoints() == resumed_host->GetPoints();
+          same = same && host->GetSymbionts().size() == resumed_host->GetSymbionts().size();
+          for (size_t j = 0; same && j < host->GetSymbionts().size(); j++) {
+            same = host->GetSymbionts()[j]->GetIntVal() == resumed_host->GetSymbionts()[j]->GetIntVal();
+          }
+          emp::Ptr<Organism> sym = world.GetSymPop()[i];
+          emp::Ptr<Organism> resumed_sym = resumed.GetSymPop()[i];
+          same = same && (bool) sym == (bool) resumed_sym;
+          if (sym && resumed_sym) same = same && sym->GetIntVal() == resumed_sym->GetIntVal();
+        }
+        REQUIRE(same);
+        REQUIRE(random.GetUInt() == resumed_random.GetUInt());
+      }
+    }
+    std::remove("checkpoint_test.chk");
+  }
+}
+
+TEST_CASE("Compact interaction map", "[default]") {
+  GIVEN("An interaction map") {
+    datastruct::InteractionMap interactions;
+
+    WHEN("A few symbiont taxa are added out of order") {
+      interactions.Add(7);
+      interactions.Add(3);
+      interactions.Add(7, 2);
+
+      THEN("The counts are kept flat and visited in order of taxon ID") {
+        REQUIRE(!interactions.IsSpilled());
+        REQUIRE(interactions.size() == 2);
+        REQUIRE(interactions.Get(7) == 3);
+        REQUIRE(!interactions.Has(5));
+        emp::vector<unsigned long long int> ids;
+        interactions.ForEach([&](unsigned long long int id, int count) { ids.push_back(id); });
+        REQUIRE(ids == emp::vector<unsigned long long int>{3, 7});
+        REQUIRE(interactions.GetMemoryBytes() >= 2 * sizeof(datastruct::InteractionMap::entry_t));
+      }
+    }
+
+    WHEN("More symbiont taxa are added than fit flat") {
+      for (size_t id = datastruct::InteractionMap::FLAT_LIMIT + 1; id > 0; id--) interactions.Add(id);
+      interactions.Add(1);
+
+      THEN("The counts move into a hash map but keep their order and values") {
+        REQUIRE(interactions.IsSpilled());
+        REQUIRE(interactions.size() == datastruct::InteractionMap::FLAT_LIMIT + 1);
+        REQUIRE(interactions.Get(1) == 2);
+        unsigned long long int last_id = 0;
+        interactions.ForEach([&](unsigned long long int id, int count) {
+          REQUIRE(id > last_id);
+          last_id = id;
+        });
+        datastruct::InteractionMap copy = interactions;
+        interactions.clear();
+        REQUIRE(!interactions.IsSpilled());
+        REQUIRE(interactions.empty());
+        REQUIRE(copy.IsSpilled());
+        REQUIRE(copy.Get(1) == 2);
+      }
+    }
+
+    THEN("A map that never spills carries no more than its vector and a pointer") {
+      REQUIRE(sizeof(datastruct::InteractionMap) <= sizeof(emp::vector<datastruct::InteractionMap::entry_t>) + sizeof(void *));
+    }
+  }
+
+  GIVEN("An interaction table") {
+    datastruct::InteractionTable table;
+    table.Add(2, 5);
+    table.Add(1, 9);
+    table.Add(2, 5, 3);
+
+    WHEN("It is finalized") {
+      table.Finalize();
+
+      THEN("Repeated pairs are merged and the pairs are sorted") {
+        REQUIRE(table.GetEntries().size() == 2);
+        REQUIRE(table.GetEntries()[0].first == datastruct::InteractionTable::key_t(1, 9));
+        REQUIRE(table.GetEntries()[1].first == datastruct::InteractionTable::key_t(2, 5));
+        REQUIRE(table.GetEntries()[1].second == 4);
+      }
+    }
+  }
+
+  GIVEN("A world tracking phylogeny interactions") {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.PHYLOGENY(1);
+    config.TRACK_PHYLOGENY_INTERACTIONS(1);
+    SymWorld world(random, &config);
+    REQUIRE(world.GetInteractionMemoryBytes() == 0);
+
+    WHEN("A symbiont is injected into a host") {
+      emp::Ptr<Organism> symbiont = emp::NewPtr<Symbiont>(&random, &world, &config, -1);
+      emp::Ptr<Organism> host = emp::NewPtr<Host>(&random, &world, &config, -1);
+      world.InjectHost(host);
+      world.Resize(4, 4);
+      world.InjectSymbiont(symbiont);
+
+      THEN("The memory spent on tracking the interaction is reported") {
+        REQUIRE(world.GetInteractionMemoryBytes() >= sizeof(datastruct::InteractionMap::entry_t));
+      }
+    }
+  }
+}
+
+TEST_CASE("Streaming phylogeny", "[default]") {
+  GIVEN("two worlds tracking phylogeny from the same seed, one streaming extinct taxa's interactions") {
+    SymConfigBase config;
+    config.GRID_X(10);
+    config.GRID_Y(10);
+    config.PHYLOGENY(1);
+    config.TRACK_PHYLOGENY_INTERACTIONS(1);
+    config.MUTATION_SIZE(0.1);
+    config.FILE_NAME("_stream_test");
+
+    emp::Random random(31);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    config.STREAM_PHYLOGENY(1);
+    emp::Random streaming_random(31);
+    SymWorld streaming(streaming_random, &config);
+    streaming.Setup();
+
+    // snapshot rows, with the header first and the rest in a fixed order
+    auto read_rows = [](const std::string & path) {
+      std::ifstream in(path);
+      emp::vector<std::string> lines;
+      for (std::string line; std::getline(in, line);) lines.push_back(line);
+      if (!lines.empty()) std::sort(lines.begin() + 1, lines.end());
+      return lines;
+    };
+
+    WHEN("both worlds write snapshots along the way") {
+      for (int snapshot = 0; snapshot < 3; snapshot++) {
+        for (int i = 0; i < 40; i++) {
+          world.Update();
+          streaming.Update();
+        }
+        world.WritePhylogenyFile("plain_test.data");
+        streaming.WritePhylogenyFile("stream_test.data");
+        for (std::string kind : {"Host", "Sym", "Interaction"}) {
+          REQUIRE(read_rows(kind + "Snapshot_stream_test.data") == read_rows(kind + "Snapshot_plain_test.data"));
+        }
+      }
+
+      THEN("the streamed snapshots hold exactly the rows of the plain ones") {
+        REQUIRE(read_rows("InteractionSnapshot_plain_test.data").size() > 1);
+      }
+      THEN("the interaction counts of extinct taxa are streamed out of memory") {
+        REQUIRE(streaming.GetInteractionMemoryBytes() < world.GetInteractionMemoryBytes());
+      }
+    }
+    for (std::string kind : {"Host", "Sym", "Interaction"}) {
+      std::remove((kind + "Snapshot_plain_test.data").c_str());
+      std::remove((kind + "Snapshot_stream_test.data").c_str());
+    }
+    std::remove(("InteractionPhylogenyStream_stream_test_SEED" + std::to_string(config.SEED()) + ".data").c_str());
+  }
+}
+
+TEST_CASE("Packed tag distances", "[default]") {
+  GIVEN("a column of random tags of several widths") {
+    emp::Random random(4);
+
+    auto check_width = [&random](auto width) {
+      constexpr size_t NUM_BITS = decltype(width)::value;
+      emp::HammingMetric<NUM_BITS> metric;
+      emp::vector<emp::BitSet<NUM_BITS>> tags;
+      PackedTags<NUM_BITS> packed;
+      for (size_t i = 0; i < 20; i++) {
+        tags.push_back(emp::BitSet<NUM_BITS>(random, 0.5));
+        packed.push_back(tags.back());
+      }
+      emp::BitSet<NUM_BITS> query(random, 0.5);
+      emp::vector<uint32_t> distances(15);
+      packed.Distances(PackedTags<NUM_BITS>::Pack(query), 5, 20, distances.data());
+
+      bool same = true;
+      for (size_t i = 5; i < 20; i++) {
+        same = same && (double) distances[i - 5] / NUM_BITS == metric.calculate(query, tags[i]);
+        same = same && PackedTags<NUM_BITS>::Distance(query, tags[i]) == distances[i - 5];
+      }
+      return same;
+    };
+
+    THEN("the batched distances match the Hamming metric") {
+      REQUIRE(check_width(std::integral_constant<size_t, 32>()));
+      REQUIRE(check_width(std::integral_constant<size_t, 64>()));
+      REQUIRE(check_width(std::integral_constant<size_t, 128>()));
+      REQUIRE(check_width(std::integral_constant<size_t, 512>()));
+    }
+  }
+}
+
+TEST_CASE("Tag matrix file", "[default]") {
+  GIVEN("a world of tagged hosts and symbionts") {
+    emp::Random random(8);
+    SymConfigBase config;
+    config.GRID_X(12);
+    config.GRID_Y(12);
+    config.TAG_MATCHING(1);
+    config.STARTING_TAGS_ONE_PROB(0.5);
+    config.TAG_MATRIX_SAMPLE_PROPORTION(1);
+    config.TAG_MATRIX_BINARY(1);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    auto read_file = [](const std::string & path) {
+      std::ifstream in(path, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    WHEN("the matrix is written with one thread and with several") {
+      random.ResetSeed(3);
+      world.WriteTagMatrixFile("tag_matrix_serial.data");
+      config.UPDATE_THREADS(3);
+      random.ResetSeed(3);
+      world.WriteTagMatrixFile("tag_matrix_threads.data");
+
+      THEN("the files are the same") {
+        REQUIRE(read_file("tag_matrix_serial.data") == read_file("tag_matrix_threads.data"));
+        REQUIRE(read_file("tag_matrix_serial.data.bin") == read_file("tag_matrix_threads.data.bin"));
+      }
+
+      THEN("the binary matrix holds the CSV's distances as bit counts") {
+        std::ifstream csv("tag_matrix_serial.data");
+        std::string bin = read_file("tag_matrix_serial.data.bin");
+        std::string line;
+        std::getline(csv, line); // column positions
+        size_t num_columns = std::count(line.begin(), line.end(), ',') - 1;
+        size_t num_rows = 0;
+        bool same = true;
+        while (std::getline(csv, line)) {
+          std::stringstream row(line);
+          std::string field;
+          std::getline(row, field, ','); // row position
+          for (size_t column = 0; column < num_columns; column++) {
+            std::getline(row, field, ',');
+            uint16_t distance;
+            std::memcpy(&distance, bin.data() + (num_rows * num_columns + column) * sizeof(uint16_t), sizeof(uint16_t));
+            same = same && std::abs(std::stod(field) - (double) distance / TAG_LENGTH) < 1e-5;
+          }
+          num_rows++;
+        }
+        REQUIRE(num_rows > 0);
+        REQUIRE(num_columns > 0);
+        REQUIRE(bin.size() == num_rows * num_columns * sizeof(uint16_t));
+        REQUIRE(same);
+      }
+    }
+    for (std::string name : {"tag_matrix_serial.data", "tag_matrix_threads.data"}) {
+      for (std::string ending : {"", ".bin", ".rows", ".cols"}) std::remove((name + ending).c_str());
+    }
+  }
+}
+
+TEST_CASE("Tag frequency table", "[default]") {
+  GIVEN("a tag frequency table") {
+    emp::Random random(4);
+    TagFrequencyTable table;
+    emp::vector<emp::BitSet<TAG_LENGTH>> tags;
+    for (size_t i = 0; i < 50; i++) {
+      tags.push_back(emp::BitSet<TAG_LENGTH>(random, 0.02));
+      table.Add(tags.back());
+    }
+
+    WHEN("some tags are removed") {
+      for (size_t i = 0; i < 20; i++) table.Remove(tags[i]);
+      tags.erase(tags.begin(), tags.begin() + 20);
+
+      THEN("richness and entropy match counting the remaining tags") {
+        REQUIRE(table.GetNumTags() == 30);
+        REQUIRE((int) table.GetRichness() == emp::UniqueCount(tags));
+        REQUIRE(table.GetShannonEntropy() == Approx(emp::ShannonEntropy(tags)));
+        REQUIRE(table.Matches(tags));
+      }
+    }
+
+    WHEN("every tag is removed") {
+      for (const emp::BitSet<TAG_LENGTH> & tag : tags) table.Remove(tag);
+
+      THEN("the table is empty") {
+        REQUIRE(table.GetRichness() == 0);
+        REQUIRE(table.GetShannonEntropy() == 0);
+      }
+      THEN("removing a tag it no longer counts throws") {
+        REQUIRE_THROWS(table.Remove(tags[0]));
+      }
+    }
+  }
+
+  GIVEN("a world of tagged hosts and symbionts that mutate within their lifetimes") {
+    emp::Random random(29);
+    SymConfigBase config;
+    config.GRID_X(15);
+    config.GRID_Y(15);
+    config.TAG_MATCHING(1);
+    config.STARTING_TAGS_ONE_PROB(0.5);
+    config.TAG_MUTATION_SIZE(0.05);
+    config.SYM_WITHIN_LIFETIME_MUTATION_RATE(0.2);
+    config.OUSTING(1);
+    config.SYM_LIMIT(2);
+    config.HOST_AGE_MAX(20);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.SetLazyDataNodes(true); // so the data nodes are read from the world as it is now
+    world.GetHostTagRichness();
+
+    WHEN("hosts and symbionts are born, infect, mutate and die") {
+      bool counts_matched = true;
+      for (size_t i = 0; i < 40; i++) {
+        world.Update();
+        counts_matched = counts_matched && world.CheckPopulationCounts();
+      }
+
+      THEN("the tag frequencies match a scan of the world after every update") {
+        REQUIRE(counts_matched);
+      }
+      THEN("the data nodes match counting every tag in the world") {
+        emp::vector<emp::BitSet<TAG_LENGTH>> host_tags, sym_tags;
+        for (size_t i = 0; i < world.GetSize(); i++) {
+          if (!world.IsOccupied(i)) continue;
+          host_tags.push_back(world.GetOrg(i).GetTag());
+          for (emp::Ptr<Organism> sym : world.GetOrg(i).GetSymbionts()) sym_tags.push_back(sym->GetTag());
+        }
+        REQUIRE(sym_tags.size() > 0);
+        REQUIRE(world.CheckPopulationCounts());
+        REQUIRE(world.GetHostTagRichness().GetMean() == emp::UniqueCount(host_tags));
+        REQUIRE(world.GetHostTagShannonDiversity().GetMean() == Approx(emp::ShannonEntropy(host_tags)));
+        REQUIRE(world.GetSymbiontTagRichness().GetMean() == emp::UniqueCount(sym_tags));
+        REQUIRE(world.GetSymbiontTagShannonDiversity().GetMean() == Approx(emp::ShannonEntropy(sym_tags)));
+      }
+    }
+  }
+}
+
+TEST_CASE("Poisson cutoff table", "[default]") {
+  // Pearson's chi-square statistic of draws against the Poisson distribution,
+  // with neighbouring values pooled so every bin expects at least 5 draws,
+  // and the statistic's 99.9th percentile (Wilson-Hilferty approximation)
+  auto chi_square = [](const emp::vector<size_t> & counts, size_t num_draws, double mean) {
+    double statistic = 0, cdf = 0;
+    double bin_expected = 0, bin_observed = 0, closed_expected = 0, closed_observed = 0;
+    size_t bins = 0;
+    for (size_t k = 0; (1.0 - cdf) * num_draws >= 5; k++) {
+      const double pmf = std::exp(k * std::log(mean) - mean - std::lgamma(k + 1.0));
+      cdf += pmf;
+      bin_expected += pmf * num_draws;
+      bin_observed += k < counts.size() ? counts[k] : 0;
+      if (bin_expected >= 5 && (1.0 - cdf) * num_draws >= 5) {
+        statistic += (bin_observed - bin_expected) * (bin_observed - bin_expected) / bin_expected;
+        closed_expected += bin_expected;
+        closed_observed += bin_observed;
+        bin_expected = bin_observed = 0;
+        bins++;
+      }
+    }
+    // the last bin holds the rest of the distribution
+    const double rest_expected = num_draws - closed_expected;
+    const double rest_observed = num_draws - closed_observed;
+    statistic += (rest_observed - rest_expected) * (rest_observed - rest_expected) / rest_expected;
+    const double df = bins; // bins + 1, less one for the fixed total
+    const double critical = df * std::pow(1 - 2 / (9 * df) + 3.09 * std::sqrt(2 / (9 * df)), 3);
+    return std::make_pair(statistic, critical);
+  };
+
+  GIVEN("tag cutoff tables and the generator's own Poisson draws") {
+    const size_t num_draws = 200000;
+    for (double mean : {0.5, 4.0, 40.0, 300.0}) {
+      PoissonTable table(mean);
+      emp::Random random_table(11);
+      emp::Random random_direct(11);
+      emp::vector<size_t> table_counts, direct_counts;
+      double table_sum = 0, table_square_sum = 0;
+      for (size_t i = 0; i < num_draws; i++) {
+        const uint32_t table_draw = table.Sample(random_table.GetDouble());
+        const uint32_t direct_draw = random_direct.GetPoisson(mean);
+        if (table_draw >= table_counts.size()) table_counts.resize(table_draw + 1, 0);
+        if (direct_draw >= direct_counts.size()) direct_counts.resize(direct_draw + 1, 0);
+        table_counts[table_draw]++;
+        direct_counts[direct_draw]++;
+        table_sum += table_draw;
+        table_square_sum += (double) table_draw * table_draw;
+      }
+
+      WHEN("many cutoffs are drawn with mean " + std::to_string(mean)) {
+        THEN("both samplers pass a chi-square test against the Poisson distribution") {
+          auto [table_statistic, critical] = chi_square(table_counts, num_draws, mean);
+          auto [direct_statistic, direct_critical] = chi_square(direct_counts, num_draws, mean);
+          REQUIRE(table_statistic < critical);
+          REQUIRE(direct_statistic < direct_critical);
+        }
+        THEN("the table's draws have the distribution's mean and variance") {
+          const double sample_mean = table_sum / num_draws;
+          const double sample_variance = table_square_sum / num_draws - sample_mean * sample_mean;
+          REQUIRE(std::abs(sample_mean - mean) < 5 * std::sqrt(mean / num_draws));
+          REQUIRE(sample_variance == Approx(mean).epsilon(0.02));
+        }
+      }
+    }
+  }
+
+  GIVEN("a table with mean 0") {
+    PoissonTable table(0);
+    THEN("every cutoff is 0") {
+      REQUIRE(table.Sample(0) == 0);
+      REQUIRE(table.Sample(0.999999) == 0);
+    }
+  }
+
+  GIVEN("a tag matching world") {
+    emp::Random random(5);
+    SymConfigBase config;
+    config.TAG_MATCHING(1);
+    SymWorld world(random, &config);
+
+    WHEN("TAG_DISTANCE changes") {
+      REQUIRE(world.GetTagCutoffs().GetMean() == Approx(config.TAG_DISTANCE() * TAG_LENGTH));
+      config.TAG_DISTANCE(0.5);
+
+      THEN("the cutoffs are drawn from the new distribution") {
+        REQUIRE(world.GetTagCutoffs().GetMean() == Approx(0.5 * TAG_LENGTH));
+      }
+    }
+  }
+}
+
+TEST_CASE("Neighbor table", "[default]") {
+  GIVEN("a neighbor table for a 5x4 grid") {
+    NeighborTable table;
+    table.Build(5, 4);
+
+    THEN("a cell's Moore neighborhood wraps around the edges in row-major order") {
+      // cell 0 is the top-left corner
+      const uint32_t * moore = table.GetMoore(0);
+      REQUIRE(emp::vector<uint32_t>(moore, moore + NeighborTable::MOORE_SIZE) == emp::vector<uint32_t>{19, 15, 16, 4, 0, 1, 9, 5, 6});
+    }
+    THEN("a cell's von Neumann neighborhood is above, left, right and below it") {
+      const uint32_t * von_neumann = table.GetVonNeumann(7);
+      REQUIRE(emp::vector<uint32_t>(von_neumann, von_neumann + NeighborTable::VON_NEUMANN_SIZE) == emp::vector<uint32_t>{2, 6, 8, 12});
+    }
+    THEN("an occupancy mask picks out the occupied neighbors") {
+      const uint32_t mask = table.GetOccupiedMask(6, [](size_t cell) { return cell == 0 || cell == 6 || cell == 12; });
+      REQUIRE(mask == ((1u << 0) | (1u << 8)));
+      REQUIRE(table.GetMooreNeighbor(6, NeighborTable::NthOffset(mask, 0)) == 0);
+      REQUIRE(table.GetMooreNeighbor(6, NeighborTable::NthOffset(mask, 1)) == 12);
+    }
+  }
+
+  GIVEN("a grid world with a few hosts") {
+    emp::Random random(13);
+    SymConfigBase config;
+    SymWorld world(random, &config);
+    world.SetPopStruct_Grid(6, 6, false);
+    world.Resize(6, 6);
+    for (size_t cell : {0, 8, 14, 35}) world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0.5), cell);
+
+    WHEN("an occupied neighbor of a cell is chosen many times") {
+      std::map<int, size_t> picks;
+      for (size_t i = 0; i < 600; i++) picks[world.GetNeighborHost(7)]++;
+
+      THEN("every occupied neighbor is chosen, and nothing else") {
+        REQUIRE(picks.size() == 3);
+        REQUIRE(picks.count(0));
+        REQUIRE(picks.count(8));
+        REQUIRE(picks.count(14));
+      }
+    }
+    WHEN("a cell has no occupied neighbors") {
+      THEN("none is found") {
+        REQUIRE(world.GetNeighborHost(22) == -1);
+      }
+    }
+    WHEN("the grid is resized") {
+      world.Resize(4, 3);
+
+      THEN("neighbors come from the new dimensions") {
+        REQUIRE(world.GetNeighborTable().Fits(4, 3));
+        REQUIRE(world.GetRandomNeighborPos(emp::WorldPosition(0)).GetIndex() < 12);
+      }
+    }
+  }
+}
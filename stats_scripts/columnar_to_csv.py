@@ -0,0 +1,73 @@
+#a script to convert binary columnar data files (.cdata, written when BINARY_DATA_FILES is on) back to the usual CSV .data files
+#EX: python3 columnar_to_csv.py HostVals_data_SEED10.cdata SymVals_data_SEED10.cdata
+#each FILE.cdata is written out as FILE.data, with the same header and rows the CSV writer would have produced
+import math
+import struct
+import sys
+
+MAGIC = b"SYMCOL01"
+INT64 = 0
+FLOAT64 = 1
+
+def format_float(value):
+    #matches printing a double to a C++ stream with default settings
+    if math.isnan(value):
+        return "-nan" if math.copysign(1.0, value) < 0 else "nan"
+    return "%g" % value
+
+def read_exact(in_file, size):
+    data = in_file.read(size)
+    if len(data) != size:
+        raise ValueError("truncated file")
+    return data
+
+def read_string(in_file):
+    (length,) = struct.unpack("<I", read_exact(in_file, 4))
+    return read_exact(in_file, length).decode("utf-8")
+
+def convert(in_name, out_name):
+    with open(in_name, "rb") as in_file, open(out_name, "w") as out_file:
+        if in_file.read(len(MAGIC)) != MAGIC:
+            raise ValueError(in_name + " is not a binary columnar data file")
+        (num_columns,) = struct.unpack("<I", read_exact(in_file, 4))
+        types = []
+        keys = []
+        for i in range(num_columns):
+            (column_type,) = struct.unpack("<B", read_exact(in_file, 1))
+            types.append(column_type)
+            keys.append(read_string(in_file))
+            read_string(in_file) #description
+        out_file.write(",".join(keys) + "\n")
+
+        while True:
+            header = in_file.read(4)
+            if len(header) == 0:
+                break
+            if len(header) != 4:
+                raise ValueError("truncated chunk in " + in_name)
+            (num_rows,) = struct.unpack("<I", header)
+            columns = []
+            for column_type in types:
+                (width,) = struct.unpack("<B", read_exact(in_file, 1))
+                code = "q" if column_type == INT64 else "d"
+                if width == 0: #one value shared by every row in the chunk
+                    values = struct.unpack("<" + code, read_exact(in_file, 8)) * num_rows
+                else:
+                    if column_type == INT64:
+                        code = {1: "b", 2: "h", 4: "i", 8: "q"}[width]
+                    values = struct.unpack("<" + code * num_rows, read_exact(in_file, width * num_rows))
+                if column_type == INT64:
+                    columns.append([str(v) for v in values])
+                else:
+                    columns.append([format_float(v) for v in values])
+            for row in range(num_rows):
+                out_file.write(",".join(column[row] for column in columns) + "\n")
+
+if(len(sys.argv) < 2):
+    print("usage: python3 columnar_to_csv.py FILE.cdata [FILE.cdata ...]")
+    sys.exit(1)
+
+for in_name in sys.argv[1:]:
+    out_name = in_name[:-len(".cdata")] + ".data" if in_name.endswith(".cdata") else in_name + ".data"
+    convert(in_name, out_name)
+    print("Wrote " + out_name)
@@ -0,0 +1,40 @@
+#a script to compare two runs of the benchmark suite (make bench) recorded in the same results file
+#EX: python3 compare_bench.py bench_results.csv               compares the last two labels in the file
+#EX: python3 compare_bench.py bench_results.csv abc1234 def5678   compares def5678 against abc1234
+import csv
+import sys
+
+if(len(sys.argv) < 2):
+    print("usage: python3 compare_bench.py bench_results.csv [OLD_LABEL NEW_LABEL]")
+    sys.exit(1)
+
+results = {}
+labels = []
+with open(sys.argv[1]) as in_file:
+    for row in csv.DictReader(in_file):
+        if row["label"] not in labels:
+            labels.append(row["label"])
+        #a label run more than once keeps its latest results
+        results[(row["label"], row["scenario"], row["grid_size"])] = row
+
+if(len(sys.argv) > 3):
+    old_label = sys.argv[2]
+    new_label = sys.argv[3]
+elif(len(labels) >= 2):
+    old_label = labels[-2]
+    new_label = labels[-1]
+else:
+    print("The results file needs runs with at least two labels to compare")
+    sys.exit(1)
+
+print("Comparing "+new_label+" against "+old_label+" (speedup above 1 is faster)")
+print("scenario\tsize\torg-updates/s old\torg-updates/s new\tspeedup\tpeak RSS ratio")
+for (label, scenario, size), new in results.items():
+    if label != new_label or (old_label, scenario, size) not in results:
+        continue
+    old = results[(old_label, scenario, size)]
+    old_rate = float(old["organism_updates_per_sec"])
+    new_rate = float(new["organism_updates_per_sec"])
+    speedup = new_rate/old_rate if old_rate > 0 else float("nan")
+    memory = float(new["peak_rss_kb"])/float(old["peak_rss_kb"]) if float(old["peak_rss_kb"]) > 0 else float("nan")
+    print(scenario+"\t"+size+"\t"+"{:.0f}".format(old_rate)+"\t"+"{:.0f}".format(new_rate)+"\t"+"{:.2f}".format(speedup)+"\t"+"{:.2f}".format(memory))
@@ -0,0 +1,31 @@
+#a script to time the same run with different numbers of update threads
+#RUN THREAD_SCALING.PY FROM WITHIN THE FOLDER WHERE THE DATA SHOULD GO
+#EX: INSIDE OF SymbulationEmp/Data, RUN python3 ../stats_scripts/thread_scaling.py 1 2 4 8
+import sys
+import subprocess
+import time
+
+thread_counts = [1, 2, 4, 8]
+grid_size = 500
+updates = 100
+
+if(len(sys.argv) > 1):
+    thread_counts = [int(arg) for arg in sys.argv[1:]]
+
+def silent_cmd(command):
+    return subprocess.Popen(command, shell=True, stdout=subprocess.PIPE).wait()
+
+print("Copying SymSettings.cfg and executable to current folder")
+silent_cmd("cp ../SymSettings.cfg .")
+silent_cmd("cp ../symbulation .")
+
+base_time = None
+print("threads\tseconds\tspeedup")
+for threads in thread_counts:
+    command_str = './symbulation -GRID 1 -GRID_X '+str(grid_size)+' -GRID_Y '+str(grid_size)+' -UPDATES '+str(updates)+' -UPDATE_THREADS '+str(threads)+' -FILE_NAME _Threads'+str(threads)
+    start = time.time()
+    silent_cmd(command_str)
+    elapsed = time.time() - start
+    if base_time is None:
+        base_time = elapsed
+    print(str(threads)+"\t"+"{:.2f}".format(elapsed)+"\t"+"{:.2f}".format(base_time/elapsed))